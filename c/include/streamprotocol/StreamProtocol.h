@@ -12,6 +12,14 @@ extern "C" {
 #define SP_FRAGED      0x01U
 #define SP_UNFRAGED    0x00U
 
+/* 프로토콜 버전: SP_PROTOCOL_VERSION_CRC32C 프레임은 CRC32 대신 CRC32C 트레일러를 사용합니다.
+   그 외 버전(기본값 1 포함)은 CRC32 를 사용하므로 버전 1 피어와 그대로 호환됩니다. */
+#define SP_PROTOCOL_VERSION_DEFAULT 1U
+#define SP_PROTOCOL_VERSION_CRC32C  2U
+
+/* 스트리밍 CRC 의 초기 누산 상태. 최종 체크섬은 ~상태 입니다. */
+#define SP_CRC_INIT 0xFFFFFFFFU
+
 /* 에러 코드 */
 typedef enum sp_result_e {
     SP_OK = 0,
@@ -33,6 +41,25 @@ typedef struct sp_parsed_packet_s {
     size_t   payload_length;    /* 페이로드 길이 */
 } sp_parsed_packet_t;
 
+/* 프레임 완성 콜백. packet->payload 는 디코더 버퍼 내부를 가리키며 콜백이 끝날 때까지만 유효합니다. */
+typedef void (*sp_frame_callback_t)(void* user_data, const sp_parsed_packet_t* packet);
+
+/* 호출자가 준 고정 버퍼 안에서 프레임을 조립하는 증분 디코더 (동적 할당 없음).
+   필드는 sp_decoder_* 함수로만 다루어야 합니다. */
+typedef struct sp_decoder_s {
+    uint8_t* buffer;
+    size_t   capacity;
+    size_t   fill;              /* 현재 프레임에서 버퍼에 모은 바이트 수 */
+    uint64_t packet_length;     /* 현재 프레임 길이 (헤더를 받기 전에는 0) */
+    uint64_t skip_remaining;    /* 버퍼보다 커서 건너뛰는 중인 프레임의 남은 바이트 */
+    uint32_t crc_state;
+    sp_frame_callback_t on_frame;
+    void*    user_data;
+} sp_decoder_t;
+
+/* SP_NO_MALLOC 을 정의하고 빌드하면 동적 할당을 쓰는 인코딩 함수가 빠집니다. (sp_encode_into 사용) */
+#ifndef SP_NO_MALLOC
+
 /**
  * 페이로드를 패킷으로 인코딩합니다. (동적 할당)
  *
@@ -68,6 +95,53 @@ sp_result_t sp_encode_packet_limited(const uint8_t* payload,
                                      uint8_t** out_packet,
                                      size_t* out_length);
 
+/**
+ * 프로토콜 버전을 지정하여 인코딩합니다. (동적 할당)
+ *
+ * @param protocol_version 0~15 (4비트). SP_PROTOCOL_VERSION_CRC32C 이면 CRC32C 트레일러를 사용합니다.
+ * @param max_packet_size  허용할 최대 패킷 크기 (0 이면 헤더 한계까지)
+ * 나머지 인자는 sp_encode_packet과 동일합니다.
+ */
+sp_result_t sp_encode_packet_ex(const uint8_t* payload,
+                                size_t payload_length,
+                                uint8_t frag_flag,
+                                uint8_t payload_type,
+                                uint16_t user_field,
+                                uint8_t protocol_version,
+                                size_t max_packet_size,
+                                uint8_t** out_packet,
+                                size_t* out_length);
+
+#endif /* SP_NO_MALLOC */
+
+/**
+ * protocol_version 에 해당하는 트레일러 체크섬(CRC32 또는 CRC32C)을 계산합니다.
+ */
+uint32_t sp_frame_checksum(uint8_t protocol_version, const uint8_t* data, size_t length);
+
+/**
+ * 체크섬을 나누어 계산합니다. crc_state 는 SP_CRC_INIT 에서 시작하고, 최종 값은 ~반환값 입니다.
+ */
+uint32_t sp_frame_checksum_update(uint8_t protocol_version, uint32_t crc_state, const uint8_t* data, size_t length);
+
+/**
+ * 호출자가 준 버퍼에 패킷을 인코딩합니다. (동적 할당 없음)
+ *
+ * @param out_buffer   결과를 쓸 버퍼 (정적 버퍼 등)
+ * @param out_capacity out_buffer 크기. 패킷이 들어가지 않으면 SP_ERR_BUFFER_TOO_SMALL
+ * @param out_length   쓴 패킷 길이
+ * 나머지 인자는 sp_encode_packet_ex 와 동일합니다.
+ */
+sp_result_t sp_encode_into(const uint8_t* payload,
+                           size_t payload_length,
+                           uint8_t frag_flag,
+                           uint8_t payload_type,
+                           uint16_t user_field,
+                           uint8_t protocol_version,
+                           uint8_t* out_buffer,
+                           size_t out_capacity,
+                           size_t* out_length);
+
 /**
  * 인코딩된 패킷을 파싱합니다.
  *
@@ -81,6 +155,40 @@ sp_result_t sp_parse_packet(const uint8_t* packet,
                             size_t packet_len,
                             sp_parsed_packet_t* out_packet);
 
+/**
+ * 증분 디코더를 초기화합니다.
+ *
+ * @param buffer    프레임 조립용 버퍼. capacity 보다 긴 프레임은 건너뜁니다. (최소 12바이트)
+ * @param on_frame  CRC 까지 검증된 프레임마다 호출됩니다.
+ */
+sp_result_t sp_decoder_init(sp_decoder_t* decoder,
+                            uint8_t* buffer,
+                            size_t capacity,
+                            sp_frame_callback_t on_frame,
+                            void* user_data);
+
+/** 조립 중인 프레임을 버리고 다음 바이트를 헤더 시작으로 봅니다. */
+void sp_decoder_reset(sp_decoder_t* decoder);
+
+/** 프레임 중간(헤더 일부 포함)이면 1 을 반환합니다. */
+int sp_decoder_in_frame(const sp_decoder_t* decoder);
+
+/**
+ * 받은 바이트를 넣습니다. 한 바이트씩 넣어도 되고, 바이트당 비용은 일정합니다.
+ *
+ * 오류가 나면 그 지점에서 멈추고 오류 코드를 반환하며, *consumed 에 처리한 바이트 수를 씁니다.
+ * 나머지 바이트는 다시 넣으면 됩니다.
+ * - SP_ERR_CRC_MISMATCH      : 해당 프레임은 버렸습니다. 다음 프레임부터 계속 읽습니다.
+ * - SP_ERR_PAYLOAD_TOO_LARGE : 버퍼보다 긴 프레임입니다. 나머지 바이트는 자동으로 건너뜁니다.
+ * - SP_ERR_BUFFER_TOO_SMALL  : 헤더 길이가 잘못되어 프레임 경계를 잃었습니다. 디코더는 초기화됩니다.
+ *
+ * @param consumed  처리한 바이트 수 (NULL 가능)
+ */
+sp_result_t sp_decoder_feed(sp_decoder_t* decoder,
+                            const uint8_t* data,
+                            size_t length,
+                            size_t* consumed);
+
 #ifdef __cplusplus
 }
 #endif
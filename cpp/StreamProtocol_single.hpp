@@ -3,8 +3,17 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <limits>
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 /// 단일 헤더 버전 StreamProtocol C++ 구현입니다.
 /// 이 파일 하나만 프로젝트에 포함하면 패킷 인코딩/디코딩을 사용할 수 있습니다.
@@ -79,57 +88,161 @@ public:
     const std::vector<uint8_t>& Payload() const { return payloadRaw; }
 };
 
+/// ParsedPacket 의 비소유(zero-copy) 버전입니다.
+/// 페이로드는 파싱한 원본 버퍼 내부를 가리키므로, 원본 버퍼가 유효한 동안에만 사용해야 합니다.
+class ParsedPacketView {
+private:
+    uint8_t protocolVersion = 0;
+    size_t packetLength = 0;
+    uint8_t fragmentFlag = 0;
+    uint8_t payloadType = 0;
+    uint16_t userField = 0;
+    const uint8_t* payloadData = nullptr;
+    size_t payloadSize = 0;
+
+public:
+    ParsedPacketView() = default;
+    ParsedPacketView(uint8_t ver, size_t len, uint8_t frag, uint8_t type, uint16_t user, const uint8_t* payload, size_t size)
+        : protocolVersion(ver), packetLength(len), fragmentFlag(frag), payloadType(type), userField(user), payloadData(payload), payloadSize(size) {
+    }
+
+    uint8_t ProtocolVersion() const { return protocolVersion; }
+    size_t PacketLength() const { return packetLength; }
+    uint8_t FragmentFlag() const { return fragmentFlag; }
+    uint8_t PayloadType() const { return payloadType; }
+    uint16_t UserField() const { return userField; }
+    const uint8_t* Payload() const { return payloadData; }
+    size_t PayloadSize() const { return payloadSize; }
+
+    ParsedPacket toParsedPacket() const {
+        return ParsedPacket(protocolVersion, packetLength, fragmentFlag, payloadType, userField,
+                            std::vector<uint8_t>(payloadData, payloadData + payloadSize));
+    }
+};
+
 /// 8바이트 헤더 + CRC32를 사용하는 패킷 인코더/디코더입니다.
 class StreamProtocol {
 private:
-    static constexpr size_t HEADER_SIZE = 8;               // 8 bytes
     static constexpr uint64_t MAX_HEADER_LENGTH_VALUE = 0x1FFFFFFFFFFFL; // 45-bit max
+    static constexpr size_t APPEND_CHUNK = 16u * 1024u;                   // payload copy chunk
 
-    uint8_t protocolVersion = 1; // Default protocol version (4-bit, 0-15)
+    uint8_t protocolVersion = DEFAULT_PROTOCOL_VERSION; // Default protocol version (4-bit, 0-15)
 
-    inline uint32_t computeCRC32(const uint8_t* data, size_t length) const {
-        uint32_t crc = 0xFFFFFFFF;
-        for (size_t i = 0; i < length; ++i) {
-            crc ^= data[i];
+    using SliceTables = std::array<std::array<uint32_t, 256>, 8>;
+
+    static constexpr SliceTables makeSliceTables(uint32_t polynomial) {
+        SliceTables tables{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
             for (int j = 0; j < 8; ++j) {
                 uint32_t mask = 0 - (crc & 1);
-                crc = (crc >> 1) ^ (0xEDB88320 & mask);
+                crc = (crc >> 1) ^ (polynomial & mask);
             }
+            tables[0][i] = crc;
         }
-        return ~crc;
+        for (size_t k = 1; k < 8; ++k) {
+            for (uint32_t i = 0; i < 256; ++i) {
+                tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+            }
+        }
+        return tables;
     }
 
-    inline std::vector<uint8_t> buildPacket(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
-        if (data == nullptr) {
-            throw std::invalid_argument("payload must not be null");
+    /// src 를 CRC 에 누적합니다. (최종 반전 전 상태를 주고받으므로 나누어 호출할 수 있음)
+    /// dst 가 nullptr 이 아니면 읽은 바이트를 dst 에도 써서, 복사와 CRC 를 한 번의 순회로 처리합니다.
+    /// 소프트웨어 경로는 slice-by-8 표로 8바이트씩 처리합니다.
+    static inline uint32_t updateCRC(uint32_t crc, uint8_t version, uint8_t* dst, const uint8_t* src, size_t length) {
+        static constexpr SliceTables CRC_TABLES = makeSliceTables(0xEDB88320);
+        static constexpr SliceTables CRC32C_TABLES = makeSliceTables(0x82F63B78);
+        const SliceTables& t = version == CRC32C_PROTOCOL_VERSION ? CRC32C_TABLES : CRC_TABLES;
+        for (; length >= 8; src += 8, length -= 8) {
+            uint64_t word;
+            std::memcpy(&word, src, sizeof(word));
+            if (dst) {
+                std::memcpy(dst, &word, sizeof(word));
+                dst += 8;
+            }
+#if defined(__SSE4_2__)
+            if (version == CRC32C_PROTOCOL_VERSION) {
+                crc = static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+                continue;
+            }
+#elif defined(__ARM_FEATURE_CRC32)
+            if (version == CRC32C_PROTOCOL_VERSION) {
+                crc = __crc32cd(crc, word);
+                continue;
+            }
+#endif
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            for (int i = 0; i < 8; ++i) {
+                crc = (crc >> 8) ^ t[0][(crc ^ src[i]) & 0xFF];
+            }
+#else
+            uint32_t low = static_cast<uint32_t>(word) ^ crc;
+            uint32_t high = static_cast<uint32_t>(word >> 32);
+            crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                  t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+#endif
         }
+        for (size_t i = 0; i < length; ++i) {
+            if (dst) {
+                dst[i] = src[i];
+            }
+            crc = (crc >> 8) ^ t[0][(crc ^ src[i]) & 0xFF];
+        }
+        return crc;
+    }
 
+    /// protocolVersion 2 는 CRC32C(0x82F63B78), 그 외 버전은 CRC32(0xEDB88320) 트레일러를 사용합니다.
+    inline uint32_t computeCRC32(const uint8_t* data, size_t length, uint8_t version) const {
+        return ~updateCRC(0xFFFFFFFF, version, nullptr, data, length);
+    }
+
+    /// out 을 한 조각씩 늘리며 src 를 복사하고 CRC 에 누적합니다. (페이로드를 한 번만 읽음)
+    /// resize() 의 0 채우기는 곧 덮어쓸 조각에만 일어나므로 캐시 안에서 끝납니다.
+    static inline uint32_t appendWithCRC(std::vector<uint8_t>& out, uint32_t crc, uint8_t version, const uint8_t* src, size_t size) {
+        for (size_t offset = 0; offset < size; offset += APPEND_CHUNK) {
+            size_t n = std::min(APPEND_CHUNK, size - offset);
+            size_t end = out.size();
+            out.resize(end + n);
+            crc = updateCRC(crc, version, out.data() + end, src + offset, n);
+        }
+        return crc;
+    }
+
+    /// 프레임 끝 4바이트의 CRC(little-endian)를 읽습니다.
+    static inline uint32_t readTrailer(const uint8_t* packet, size_t packetLength) {
+        uint32_t value = 0;
+        size_t crcOffset = packetLength - sizeof(uint32_t);
+        for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+            value |= (static_cast<uint32_t>(packet[crcOffset + i]) << (i * 8));
+        }
+        return value;
+    }
+
+    /// 헤더 8바이트를 쓰고 프레임 전체 길이를 반환합니다.
+    inline size_t writeHeader(uint8_t* frame, size_t payloadSize, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
         // Validate fragment flag
         if (fragFlag != FRAGED && fragFlag != UNFRAGED) {
             throw std::invalid_argument("Invalid fragment flag");
         }
 
         // Validate payload type (4-bit: 0-15)
-        uint8_t pt = payloadType & 0xFF;
-        if (pt > 0x0F) {
+        if (payloadType > 0x0F) {
             throw std::invalid_argument("payloadType must be 4 bits (0-15)");
         }
 
-        // Calculate total packet length (Header + Payload + CRC (4 bytes))
-        uint64_t totalPacketLength64 = HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t);
-        uint64_t maxPacketLength = (MAX_HEADER_LENGTH_VALUE < static_cast<uint64_t>(std::numeric_limits<size_t>::max()))
-            ? MAX_HEADER_LENGTH_VALUE
-            : static_cast<uint64_t>(std::numeric_limits<size_t>::max());
-        if (totalPacketLength64 > maxPacketLength) {
-            throw PayloadTooLargeException(totalPacketLength64, maxPacketLength);
-        }
-        size_t totalPacketLength = static_cast<size_t>(totalPacketLength64);
-
         // Validate userField (10-bit: 0-1023)
         if (userValue > 0x3FF) {
             throw std::invalid_argument("userField must be 10-bit (0-1023)");
         }
 
+        uint64_t totalPacketLength64 = HEADER_SIZE + static_cast<uint64_t>(payloadSize) + sizeof(uint32_t);
+        if (totalPacketLength64 > MAX_PACKET_LENGTH) {
+            throw PayloadTooLargeException(totalPacketLength64, MAX_PACKET_LENGTH);
+        }
+        size_t totalPacketLength = static_cast<size_t>(totalPacketLength64);
+
         // Build 64-bit header value (little-endian)
         uint64_t headerValue = 0;
         headerValue |= (static_cast<uint64_t>(protocolVersion) & 0x0F) << 0;               // 4 bits
@@ -138,28 +251,56 @@ private:
         headerValue |= (static_cast<uint64_t>(payloadType) & 0x0Fu) << 50;                // 4 bits
         headerValue |= (static_cast<uint64_t>(userValue) & 0x3FFu) << 54;                 // 10 bits
 
-        std::vector<uint8_t> packet;
-        packet.reserve(totalPacketLength);
-
-        // Insert header (8 bytes, little-endian)
+        // Write header (8 bytes, little-endian)
         for (size_t i = 0; i < HEADER_SIZE; ++i) {
-            packet.push_back(static_cast<uint8_t>((headerValue >> (i * 8)) & 0xFFu));
+            frame[i] = static_cast<uint8_t>((headerValue >> (i * 8)) & 0xFFu);
+        }
+
+        return totalPacketLength;
+    }
+
+    inline std::vector<uint8_t> buildPacket(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
+        if (data == nullptr && size != 0) {
+            throw std::invalid_argument("payload must not be null");
+        }
+
+        // Calculate total packet length (Header + Payload + CRC (4 bytes))
+        uint64_t totalPacketLength64 = HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t);
+        if (totalPacketLength64 > MAX_PACKET_LENGTH) {
+            throw PayloadTooLargeException(totalPacketLength64, MAX_PACKET_LENGTH);
         }
 
-        // Insert payload data
-        packet.insert(packet.end(), data, data + size);
+        // Reserve once, then copy the payload and fold it into the CRC in the same pass
+        std::vector<uint8_t> packet;
+        packet.reserve(static_cast<size_t>(totalPacketLength64));
+        uint8_t header[HEADER_SIZE];
+        writeHeader(header, size, payloadType, fragFlag, userValue);
+        packet.insert(packet.end(), header, header + HEADER_SIZE);
+
+        uint32_t crc = updateCRC(0xFFFFFFFF, protocolVersion, nullptr, header, HEADER_SIZE);
+        crc = appendWithCRC(packet, crc, protocolVersion, data, size);
 
-        // Calculate CRC for header + payload
-        uint32_t crc = computeCRC32(packet.data(), packet.size());
-        const uint8_t* crcBytes = reinterpret_cast<const uint8_t*>(&crc);
-        packet.insert(packet.end(), crcBytes, crcBytes + sizeof(uint32_t));
+        crc = ~crc;
+        for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+            packet.push_back(static_cast<uint8_t>((crc >> (i * 8)) & 0xFFu));
+        }
 
         return packet;
     }
 
 public:
+    static constexpr size_t HEADER_SIZE = 8;               // 8 bytes
     static constexpr uint8_t FRAGED = 0x01;
     static constexpr uint8_t UNFRAGED = 0x00;
+    /// 이 버전으로 인코딩한 프레임은 CRC32C 트레일러를 사용합니다. (버전 1 피어와는 기본 버전으로 통신)
+    static constexpr uint8_t DEFAULT_PROTOCOL_VERSION = 1;
+    static constexpr uint8_t CRC32C_PROTOCOL_VERSION = 2;
+
+    static constexpr size_t MAX_PACKET_LENGTH = static_cast<size_t>(
+        (MAX_HEADER_LENGTH_VALUE < static_cast<uint64_t>(std::numeric_limits<size_t>::max()))
+            ? MAX_HEADER_LENGTH_VALUE
+            : static_cast<uint64_t>(std::numeric_limits<size_t>::max()));
+    static constexpr size_t FRAME_OVERHEAD = HEADER_SIZE + sizeof(uint32_t); // header + CRC
 
     /// 문자열 페이로드를 인코딩합니다.
     /// @param payload   전송할 문자열 데이터
@@ -176,21 +317,91 @@ public:
         return buildPacket(payload.data(), payload.size(), 0x00u, fragFlag, userValue);
     }
 
+    /// 바이트 배열 페이로드의 저장 공간을 재사용하여 인코딩합니다. (용량이 충분하면 새 할당 없음)
+    inline std::vector<uint8_t> toBytes(std::vector<uint8_t>&& payload,
+                                        uint8_t fragFlag = UNFRAGED,
+                                        uint16_t userValue = 0x00) const {
+        size_t size = payload.size();
+        if (HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t) > MAX_PACKET_LENGTH) {
+            throw PayloadTooLargeException(HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t), MAX_PACKET_LENGTH);
+        }
+
+        std::vector<uint8_t> packet(std::move(payload));
+        packet.resize(size + FRAME_OVERHEAD);
+        if (size != 0) {
+            std::memmove(packet.data() + HEADER_SIZE, packet.data(), size);
+        }
+        sealFrame(packet.data(), size, 0x00u, fragFlag, userValue);
+        return packet;
+    }
+
+    /// payloadType 을 직접 지정하여 원시 바이트 페이로드를 인코딩합니다.
+    inline std::vector<uint8_t> toBytes(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const {
+        return buildPacket(data, size, payloadType, fragFlag, userValue);
+    }
+
+    /// 제자리 인코딩: frame[8 .. 8+payloadSize) 에 이미 들어 있는 페이로드 앞뒤에 헤더와 CRC를 기록합니다.
+    /// 기록된 전체 프레임 길이를 반환합니다.
+    inline size_t sealFrame(uint8_t* frame, size_t payloadSize, uint8_t payloadType, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const {
+        if (frame == nullptr) {
+            throw std::invalid_argument("frame must not be null");
+        }
+
+        size_t totalPacketLength = writeHeader(frame, payloadSize, payloadType, fragFlag, userValue);
+
+        // Calculate CRC for header + payload and append it (little-endian)
+        size_t crcOffset = totalPacketLength - sizeof(uint32_t);
+        uint32_t crc = computeCRC32(frame, crcOffset, protocolVersion);
+        for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+            frame[crcOffset + i] = static_cast<uint8_t>((crc >> (i * 8)) & 0xFFu);
+        }
+
+        return totalPacketLength;
+    }
+
     /// 인코딩된 패킷을 파싱하여 ParsedPacket으로 반환합니다.
     /// CRC/길이/버퍼 관련 검증에 실패하면 예외를 던집니다.
     inline ParsedPacket parsePacket(const std::vector<uint8_t>& packetBytes) const {
-        if (packetBytes.size() < HEADER_SIZE + sizeof(uint32_t)) {
-            throw BufferTooSmallException(packetBytes.size());
+        ParsedPacketView frame = checkFrame(packetBytes.data(), packetBytes.size());
+
+        // Copy the payload out and fold it into the CRC in the same pass, then compare against the trailer
+        uint32_t crc = updateCRC(0xFFFFFFFF, frame.ProtocolVersion(), nullptr, packetBytes.data(), HEADER_SIZE);
+        std::vector<uint8_t> payload;
+        payload.reserve(frame.PayloadSize());
+        uint32_t computedCRC = ~appendWithCRC(payload, crc, frame.ProtocolVersion(), frame.Payload(), frame.PayloadSize());
+
+        uint32_t receivedCRC = readTrailer(packetBytes.data(), frame.PacketLength());
+        if (computedCRC != receivedCRC) {
+            throw InvalidCRCException(receivedCRC, computedCRC);
         }
 
-        uint64_t maxPacketLength = (MAX_HEADER_LENGTH_VALUE < static_cast<uint64_t>(std::numeric_limits<size_t>::max()))
-            ? MAX_HEADER_LENGTH_VALUE
-            : static_cast<uint64_t>(std::numeric_limits<size_t>::max());
+        return ParsedPacket(frame.ProtocolVersion(), frame.PacketLength(), frame.FragmentFlag(), frame.PayloadType(),
+                            frame.UserField(), std::move(payload));
+    }
+
+    /// 페이로드를 복사하지 않고 파싱합니다. 반환된 뷰는 packet 내부를 가리킵니다.
+    inline ParsedPacketView parsePacketView(const uint8_t* packet, size_t size) const {
+        ParsedPacketView frame = checkFrame(packet, size);
+
+        uint32_t receivedCRC = readTrailer(packet, frame.PacketLength());
+        uint32_t computedCRC = computeCRC32(packet, frame.PacketLength() - sizeof(uint32_t), frame.ProtocolVersion());
+        if (computedCRC != receivedCRC) {
+            throw InvalidCRCException(receivedCRC, computedCRC);
+        }
+
+        return frame;
+    }
+
+    /// 버퍼 길이와 헤더만 검증합니다. 반환된 뷰의 CRC 는 아직 확인하지 않은 상태입니다.
+    inline ParsedPacketView checkFrame(const uint8_t* packet, size_t size) const {
+        if (packet == nullptr || size < HEADER_SIZE + sizeof(uint32_t)) {
+            throw BufferTooSmallException(packet == nullptr ? 0 : size);
+        }
 
         // Read 64-bit header (little-endian)
         uint64_t headerValue = 0;
         for (size_t i = 0; i < HEADER_SIZE; ++i) {
-            headerValue |= (static_cast<uint64_t>(packetBytes[i]) << (i * 8));
+            headerValue |= (static_cast<uint64_t>(packet[i]) << (i * 8));
         }
 
         uint8_t protoVersion = static_cast<uint8_t>((headerValue >> 0) & 0x0F);
@@ -203,32 +414,18 @@ public:
             throw BufferTooSmallException(packetLength64);
         }
 
-        if (packetLength64 > maxPacketLength) {
-            throw PayloadTooLargeException(packetLength64, maxPacketLength);
+        if (packetLength64 > MAX_PACKET_LENGTH) {
+            throw PayloadTooLargeException(packetLength64, MAX_PACKET_LENGTH);
         }
 
         size_t packetLength = static_cast<size_t>(packetLength64);
 
-        if (packetBytes.size() != packetLength) {
-            throw PacketSizeMismatch(packetBytes.size(), packetLength);
+        if (size != packetLength) {
+            throw PacketSizeMismatch(size, packetLength);
         }
 
-        // Extract received CRC
-        uint32_t receivedCRC = 0;
-        size_t crcOffset = packetLength - sizeof(uint32_t);
-        for (int i = 0; i < 4; ++i) {
-            receivedCRC |= (static_cast<uint32_t>(packetBytes[crcOffset + i]) << (i * 8));
-        }
-
-        uint32_t computedCRC = computeCRC32(packetBytes.data(), packetLength - sizeof(uint32_t));
-        if (computedCRC != receivedCRC) {
-            throw InvalidCRCException(receivedCRC, computedCRC);
-        }
-
-        std::vector<uint8_t> payload(packetBytes.begin() + HEADER_SIZE,
-                                     packetBytes.begin() + packetLength - sizeof(uint32_t));
-
-        return ParsedPacket(protoVersion, packetLength, fragmentFlag, payloadType, userField, std::move(payload));
+        return ParsedPacketView(protoVersion, packetLength, fragmentFlag, payloadType, userField,
+                                packet + HEADER_SIZE, packetLength - HEADER_SIZE - sizeof(uint32_t));
     }
 
     /// 인코딩에 사용할 프로토콜 버전을 설정합니다. (0~15)
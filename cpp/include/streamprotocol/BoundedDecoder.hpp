@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FrameHeader.hpp"
+#include "FrameReader.hpp"
+#include "ReceiveBudget.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 메모리 사용량 상한을 지키며 프레임 전체를 모아 넘기는 수신 디코더입니다.
+///
+/// 헤더 8바이트만 보고 프레임을 받을지 결정합니다. 선언된 길이가 연결별 maxFrameSize 를 넘거나,
+/// 공유 ReceiveBudget 에서 페이로드 크기만큼 예약하지 못하면 overflow 정책을 따릅니다.
+/// - Reject : PayloadTooLargeException / PacketException 을 던집니다. (연결을 끊어야 함)
+/// - Drop   : 할당 없이 해당 프레임의 바이트를 건너뛰고 onDropped 로 알립니다.
+/// - Spill  : 페이로드를 spillDirectory 의 이름 없는 임시 파일에 써서 onSpilled 로 넘깁니다. (POSIX)
+///            maxSpillSize 보다 큰 프레임은 버립니다.
+/// 받아들인 프레임의 페이로드 버퍼는 헤더 시점에 예약한 예산 안에서만 할당되며, Frame 의 lease 가
+/// 소멸할 때 예산이 돌아옵니다. CRC 가 틀린 프레임은 넘기지 않고 crcErrors 로 셉니다.
+/// 인스턴스는 연결을 처리하는 한 스레드에서만 사용해야 합니다. (ReceiveBudget 은 공유 가능)
+class BoundedDecoder {
+public:
+    enum class Overflow { Reject, Drop, Spill };
+    enum class DropReason { FrameTooLarge, BudgetExhausted, SpillTooLarge };
+
+    struct Options {
+        uint64_t maxFrameSize = 16u * 1024u * 1024u;      // 연결별 프레임 길이 상한 (헤더 + 페이로드 + CRC)
+        Overflow overflow = Overflow::Drop;
+        std::string spillDirectory = "/tmp";
+        uint64_t maxSpillSize = 1ull << 32;
+    };
+
+    struct Frame {
+        FrameHeader header;
+        std::vector<uint8_t> payload;
+        ReceiveBudget::Lease lease;     // 예산을 쓰지 않는 디코더면 비어 있음
+    };
+
+    /// 임시 파일로 받은 프레임입니다. 페이로드는 fd 의 오프셋 0 부터 size 바이트이며, 소멸 시 fd 를 닫습니다.
+    class SpilledFrame {
+    private:
+        int fd = -1;
+
+    public:
+        FrameHeader header;
+        uint64_t size = 0;
+
+        SpilledFrame() = default;
+        SpilledFrame(int fd, const FrameHeader& header, uint64_t size) : fd(fd), header(header), size(size) {}
+        SpilledFrame(SpilledFrame&& other) noexcept;
+        SpilledFrame& operator=(SpilledFrame&& other) noexcept;
+        SpilledFrame(const SpilledFrame&) = delete;
+        SpilledFrame& operator=(const SpilledFrame&) = delete;
+        ~SpilledFrame();
+
+        int Fd() const { return fd; }
+        /// payload[offset, offset + length) 를 읽습니다. 실패 시 std::system_error.
+        void read(uint64_t offset, uint8_t* out, size_t length) const;
+    };
+
+    struct Callbacks {
+        std::function<void(Frame&&)> onFrame;                                   // 필수
+        std::function<void(SpilledFrame&&)> onSpilled;                          // Spill 정책이면 필수
+        std::function<void(const FrameHeader&, DropReason)> onDropped;          // 선택
+    };
+
+    struct Stats {
+        uint64_t framesDelivered = 0;
+        uint64_t framesSpilled = 0;
+        uint64_t framesDropped = 0;
+        uint64_t bytesDropped = 0;
+        uint64_t crcErrors = 0;
+    };
+
+private:
+    enum class Mode { Buffer, Spill, Discard };
+
+    Callbacks callbacks;
+    Options options;
+    ReceiveBudget* budget;
+    FrameReader reader;
+
+    Mode mode = Mode::Discard;
+    Frame current;
+    int spillFd = -1;
+    Stats stats;
+
+    void onHeader(const FrameHeader& header);
+    void onPayload(const uint8_t* data, size_t size);
+    void onEnd(const FrameHeader& header, bool crcValid);
+    void overflow(const FrameHeader& header, DropReason reason);
+    void closeSpill();
+
+public:
+    /// budget 이 nullptr 이면 연결별 maxFrameSize 만 적용합니다. budget 은 디코더보다 오래 살아야 합니다.
+    BoundedDecoder(const StreamProtocol& protocol, ReceiveBudget* budget, Callbacks callbacks);
+    BoundedDecoder(const StreamProtocol& protocol, ReceiveBudget* budget, Callbacks callbacks, const Options& options);
+    ~BoundedDecoder();
+    BoundedDecoder(const BoundedDecoder&) = delete;
+    BoundedDecoder& operator=(const BoundedDecoder&) = delete;
+
+    /// 연결에서 읽은 바이트를 넣습니다. 콜백은 이 호출 안에서 실행됩니다.
+    void feed(const uint8_t* data, size_t size);
+
+    bool InFrame() const { return reader.InFrame(); }
+    const Stats& GetStats() const { return stats; }
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 캡처 파일의 레코드 하나입니다.
+struct CaptureRecord {
+    uint64_t timestampNs = 0;       // 캡처 시작 시점부터 프레임 마지막 바이트가 도착할 때까지의 시간
+    std::vector<uint8_t> frame;     // 헤더 + 페이로드 + CRC (받은 그대로)
+};
+
+/// 캡처 파일 포맷:
+///   파일 헤더 : "SPCAP001" (8바이트)
+///   레코드    : [timestampNs u64 LE][frameLength u64 LE][frame bytes]
+class CaptureWriter {
+private:
+    std::ostream& out;
+
+public:
+    static constexpr char MAGIC[9] = "SPCAP001";
+
+    /// 파일 헤더를 바로 씁니다.
+    explicit CaptureWriter(std::ostream& out);
+
+    void write(uint64_t timestampNs, const uint8_t* frame, size_t size);
+    void flush() { out.flush(); }
+};
+
+class CaptureReader {
+private:
+    std::istream& in;
+    uint64_t maxFrameSize;
+
+public:
+    /// 파일 헤더를 읽어 확인합니다. 캡처 파일이 아니면 PacketException.
+    explicit CaptureReader(std::istream& in, uint64_t maxFrameSize = StreamProtocol::MAX_PACKET_LENGTH);
+
+    /// 다음 레코드를 읽습니다. 파일 끝이면 false, 레코드가 잘렸으면 PacketException.
+    bool next(CaptureRecord& record);
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 하나의 프레임 연결 위에 최대 1024개의 논리 채널을 올리는 멀티플렉서입니다.
+///
+/// - 채널 번호는 헤더의 userField(10비트)를 그대로 사용합니다.
+/// - 채널마다 크레딧 기반 흐름 제어를 합니다. 송신 측은 받은 크레딧만큼만 페이로드를 보내고,
+///   수신 측은 애플리케이션이 receive() 로 소비한 만큼 PayloadType::MUX_CONTROL 프레임으로 크레딧을 돌려줍니다.
+///   따라서 느린 소비자는 자기 채널만 멈추게 하고 다른 채널을 막지 않습니다.
+/// - 송신 프레임은 가중치 기반 Deficit Round Robin 으로 채널 간에 공정하게 스케줄링됩니다.
+///
+/// 소켓을 직접 다루지 않습니다. nextFrame() 으로 보낼 프레임을 꺼내 쓰고,
+/// 받은 프레임은 onFrame() 으로 넣어 줍니다. 인스턴스는 연결을 처리하는 한 스레드에서만 사용해야 합니다.
+class ChannelMux {
+public:
+    static constexpr size_t MAX_CHANNELS = 1024;
+
+    struct Options {
+        uint32_t initialWindow = 256u * 1024u;      // 채널별 초기 크레딧 (양쪽이 같아야 함)
+        size_t maxQueuedSendBytes = 1024u * 1024u;  // 채널별 송신 대기열 한도
+        uint32_t quantum = 16u * 1024u;             // DRR 한 바퀴당 기본 송신량 (가중치 1 기준)
+    };
+
+    struct ChannelStats {
+        uint64_t framesSent = 0;
+        uint64_t bytesSent = 0;
+        uint64_t framesReceived = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t creditStalls = 0;       // 크레딧 부족으로 송신이 멈춘 횟수
+    };
+
+private:
+    struct Channel {
+        uint32_t weight = 1;
+        int64_t sendCredit = 0;
+        int64_t deficit = 0;
+        bool scheduled = false;
+        bool turnStarted = false;
+        std::deque<std::vector<uint8_t>> sendQueue;
+        size_t queuedBytes = 0;
+
+        std::deque<ParsedPacket> receiveQueue;
+        uint64_t receiveOutstanding = 0;    // 받았지만 아직 크레딧을 돌려주지 않은 바이트
+        uint64_t consumedSinceUpdate = 0;
+
+        ChannelStats stats;
+    };
+
+    StreamProtocol& protocol;
+    Options options;
+    std::vector<std::unique_ptr<Channel>> channels;
+    std::deque<uint16_t> activeChannels;
+    std::deque<std::vector<uint8_t>> controlQueue;
+    std::function<void(uint16_t)> readableCallback;
+
+    Channel& channelAt(uint16_t channel);
+    void schedule(uint16_t channel, Channel& state);
+    bool canSend(const Channel& state, size_t payloadSize) const;
+    void queueWindowUpdate(uint16_t channel, uint32_t increment);
+    void handleControl(uint16_t channel, const uint8_t* payload, size_t size);
+
+public:
+    explicit ChannelMux(StreamProtocol& protocol);
+    ChannelMux(StreamProtocol& protocol, const Options& options);
+
+    /// 채널의 스케줄링 가중치를 설정합니다. (1 이상)
+    void SetWeight(uint16_t channel, uint32_t weight);
+    /// 수신 프레임이 들어와 채널이 읽을 수 있게 되었을 때 호출됩니다.
+    void SetReadableCallback(std::function<void(uint16_t)> callback) { readableCallback = std::move(callback); }
+
+    // ---- 송신 ----
+
+    /// 채널에 페이로드를 대기시킵니다. 채널 송신 대기열이 가득 차 있으면 false.
+    bool send(uint16_t channel, const uint8_t* data, size_t size, uint8_t payloadType = PayloadType::BINARY,
+              uint8_t fragFlag = StreamProtocol::UNFRAGED);
+    /// 연결에 쓸 다음 프레임을 꺼냅니다. 크레딧 반환 프레임이 데이터보다 먼저 나갑니다.
+    bool nextFrame(std::vector<uint8_t>& frame);
+    /// 지금 보낼 수 있는 프레임이 있는지 여부입니다. (크레딧이 없는 채널은 제외)
+    bool HasOutput() const { return !controlQueue.empty() || !activeChannels.empty(); }
+
+    int64_t SendCredit(uint16_t channel) const;
+    size_t QueuedSendBytes(uint16_t channel) const;
+
+    // ---- 수신 ----
+
+    /// 연결에서 받은 프레임을 넣습니다. 흐름 제어 위반 시 PacketException 을 던집니다.
+    void onFrame(const ParsedPacketView& frame);
+    void onFrame(ParsedPacket&& frame);
+
+    /// 채널에서 다음 프레임을 꺼냅니다. 꺼낸 만큼 상대에게 크레딧이 반환됩니다.
+    std::optional<ParsedPacket> receive(uint16_t channel);
+    size_t PendingFrames(uint16_t channel) const;
+
+    ChannelStats Stats(uint16_t channel) const;
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 페이로드 압축 코덱 인터페이스입니다.
+/// 구현체는 상태를 가지지 않아야 하며 여러 스레드에서 동시에 호출될 수 있습니다.
+class PayloadCodec {
+public:
+    virtual ~PayloadCodec() = default;
+
+    /// rawSize 바이트 입력에 대해 compress() 가 필요로 할 수 있는 최대 출력 크기입니다.
+    virtual size_t maxCompressedSize(size_t rawSize) const = 0;
+
+    /// src 를 dst 에 압축하고 압축된 길이를 반환합니다.
+    /// 결과가 dstCapacity 에 들어가지 않으면 0 을 반환합니다. (압축 이득 없음)
+    virtual size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) const = 0;
+
+    /// src 를 정확히 rawSize 바이트로 복원하여 dst 에 씁니다.
+    /// 입력이 손상된 경우 PacketException 을 던집니다.
+    virtual void decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t rawSize) const = 0;
+};
+
+/// 외부 의존성이 없는 LZ77 계열 블록 코덱입니다. (LZ4 블록 포맷과 같은 시퀀스 구조)
+/// 압축률보다 속도를 우선하며, 64KB 윈도우와 단일 해시 테이블만 사용합니다.
+class LZCodec : public PayloadCodec {
+public:
+    size_t maxCompressedSize(size_t rawSize) const override;
+    size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) const override;
+    void decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t rawSize) const override;
+};
+
+/// 인코딩/파싱 파이프라인에 끼워 넣는 선택적 압축 단계입니다.
+///
+/// 압축된 프레임은 코덱에 예약된 payloadType 으로 전송되며, 페이로드는 다음과 같습니다.
+///   [ 원래 payloadType (1바이트) ][ 원본 길이 (LEB128) ][ 코덱 출력 ]
+/// 프레임마다 압축을 시도하고, 이득이 MinSavings 보다 작으면 원본 그대로 전송합니다.
+/// 내부 스크래치 버퍼를 재사용하므로 인스턴스는 스레드마다 따로 두어야 합니다.
+class PayloadCompressor {
+private:
+    struct Entry {
+        uint8_t payloadType;
+        std::shared_ptr<const PayloadCodec> codec;
+    };
+
+    StreamProtocol& protocol;
+    std::vector<Entry> codecs;
+    const PayloadCodec* encodeCodec = nullptr;
+    uint8_t encodeType = 0;
+    size_t minPayloadSize = 64;
+    size_t minSavings = 16;
+    size_t maxDecompressedSize = 64u * 1024u * 1024u;
+    std::vector<uint8_t> scratch;
+
+    const PayloadCodec* findCodec(uint8_t payloadType) const;
+
+public:
+    /// 내장 LZCodec 을 PayloadType::COMPRESSED_LZ 로 등록하고 인코딩 기본값으로 사용합니다.
+    explicit PayloadCompressor(StreamProtocol& protocol);
+
+    /// 코덱을 예약된 payloadType(0x08~0x0F)에 등록합니다. 같은 타입이 이미 있으면 교체하고, 범위 밖이면 std::invalid_argument.
+    void registerCodec(uint8_t payloadType, std::shared_ptr<const PayloadCodec> codec);
+    /// 인코딩에 사용할 코덱을 선택합니다. 등록되지 않은 타입이면 std::invalid_argument.
+    void SetEncodeCodec(uint8_t payloadType);
+    /// 압축을 끕니다. 디코딩은 계속 동작합니다.
+    void DisableEncoding();
+
+    /// 이 크기 미만의 페이로드는 압축을 시도하지 않습니다.
+    void SetMinPayloadSize(size_t bytes) { minPayloadSize = bytes; }
+    /// 압축 결과가 최소 이만큼 작아야 압축 프레임을 보냅니다.
+    void SetMinSavings(size_t bytes) { minSavings = bytes; }
+    /// 디코딩 시 허용할 최대 원본 길이입니다. (악의적인 길이 필드 방어)
+    void SetMaxDecompressedSize(size_t bytes) { maxDecompressedSize = bytes; }
+
+    bool isCompressedType(uint8_t payloadType) const { return findCodec(payloadType) != nullptr; }
+
+    std::vector<uint8_t> toBytes(const uint8_t* data, size_t size, uint8_t payloadType,
+                                 uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+    std::vector<uint8_t> toBytes(const std::string& payload,
+                                 uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+
+    /// 압축 페이로드에 기록된 원본 길이를 반환합니다. 압축 타입이 아니면 size 그대로입니다.
+    size_t decompressedSize(const uint8_t* payload, size_t size, uint8_t payloadType) const;
+
+    /// 페이로드를 복원하여 호출자 버퍼 dst 에 씁니다. (dstCapacity 가 부족하면 BufferTooSmallException)
+    /// 원래 payloadType 을 반환하고, 복원된 길이를 written 에 기록합니다.
+    uint8_t decompressInto(const uint8_t* payload, size_t size, uint8_t payloadType,
+                           uint8_t* dst, size_t dstCapacity, size_t& written) const;
+
+    /// 페이로드를 복원하여 out 에 씁니다. out 의 기존 capacity 를 재사용하므로 풀링된 버퍼를 넘기면 됩니다.
+    /// 원래 payloadType 을 반환합니다.
+    uint8_t decompress(const ParsedPacket& packet, std::vector<uint8_t>& out) const;
+};
+
+} // namespace streamprotocol
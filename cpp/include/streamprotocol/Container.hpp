@@ -0,0 +1,159 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "FrameBuffer.hpp"
+#include "ParsedPacketView.hpp"
+#include "PayloadType.hpp"
+#include "SendCoalescer.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 컨테이너 프레임 안의 하위 레코드 하나입니다. data 는 프레임 버퍼 내부를 가리킵니다.
+struct ContainerRecord {
+    uint8_t payloadType = 0;
+    uint16_t userField = 0;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+/// PayloadType::CONTAINER 프레임의 페이로드를 하위 레코드 단위로 순회합니다. (복사 없음)
+///
+/// 페이로드는 레코드의 연속입니다.
+///   [ 태그 (2바이트 LE: 비트 0-9 userField, 10-13 payloadType, 14-15 예약(0)) ][ 길이 (LEB128) ][ 데이터 ]
+/// 생성 시 전체 구조를 한 번 검증하므로(잘리거나 잘못된 레코드는 PacketException), 순회 중에는 예외가 없습니다.
+/// 원본 버퍼가 유효한 동안에만 사용해야 합니다.
+class ContainerReader {
+public:
+    class Iterator {
+    private:
+        const uint8_t* cursor = nullptr;
+        const uint8_t* limit = nullptr;
+        size_t next = 0;
+        ContainerRecord record;
+
+        void load();
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ContainerRecord;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ContainerRecord*;
+        using reference = const ContainerRecord&;
+
+        Iterator() = default;
+        Iterator(const uint8_t* begin, const uint8_t* end);
+
+        const ContainerRecord& operator*() const { return record; }
+        const ContainerRecord* operator->() const { return &record; }
+        Iterator& operator++();
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const Iterator& other) const { return cursor == other.cursor; }
+        bool operator!=(const Iterator& other) const { return cursor != other.cursor; }
+    };
+
+private:
+    const uint8_t* payload = nullptr;
+    size_t size = 0;
+    size_t count = 0;
+
+public:
+    /// frame 의 payloadType 이 CONTAINER 가 아니면 std::invalid_argument.
+    explicit ContainerReader(const ParsedPacketView& frame);
+    ContainerReader(const uint8_t* payload, size_t size);
+
+    Iterator begin() const { return Iterator(payload, payload + size); }
+    Iterator end() const { return Iterator(payload + size, payload + size); }
+    size_t RecordCount() const { return count; }
+};
+
+/// 작은 메시지를 하위 레코드로 모아 PayloadType::CONTAINER 프레임 하나(헤더 1개, CRC 1개)로 보내는 송신 측 빌더입니다.
+///
+/// 컨테이너 페이로드가 maxPayloadSize 를 넘거나, 레코드 수가 maxRecords 에 이르거나,
+/// 첫 레코드를 넣은 지 maxDelay 가 지나면 프레임을 봉인해 싱크로 넘깁니다.
+/// maxPayloadSize 에 혼자서도 들어가지 않는 레코드는 대기 중인 레코드를 먼저 내보낸 뒤 일반 프레임으로 보냅니다.
+/// 레코드가 하나뿐인 컨테이너도 일반 프레임으로 보냅니다. (수신 측은 두 형태를 모두 처리해야 합니다)
+///
+/// SendCoalescer 와 같이 쓰면 봉인된 컨테이너가 송신 배치에 들어갑니다. 마감 시각 처리는
+/// SendCoalescer 와 마찬가지로 호출자가 NextDeadline() 까지 기다린 뒤 poll() 을 부르는 방식입니다.
+/// 인스턴스는 한 스레드에서만 사용해야 합니다.
+class ContainerBuilder {
+public:
+    using Clock = std::chrono::steady_clock;
+    /// 봉인된 프레임을 받는 함수입니다.
+    using Sink = std::function<void(std::vector<uint8_t>&&)>;
+
+    static constexpr size_t RECORD_TAG_SIZE = 2;
+
+    struct Options {
+        size_t maxPayloadSize = 16u * 1024u;    // 컨테이너 페이로드(레코드 태그/길이 포함) 한도
+        size_t maxRecords = 1024;
+        std::chrono::nanoseconds maxDelay = std::chrono::microseconds(50);
+        uint16_t userField = 0;                 // 컨테이너 프레임 헤더의 userField
+    };
+
+    struct Metrics {
+        uint64_t containers = 0;      // 레코드 2개 이상으로 보낸 컨테이너 프레임
+        uint64_t records = 0;         // 컨테이너에 담아 보낸 레코드
+        uint64_t single = 0;          // 혼자라서 일반 프레임으로 보낸 레코드
+        uint64_t oversized = 0;       // maxPayloadSize 를 넘어 일반 프레임으로 보낸 레코드
+        uint64_t savedBytes = 0;      // 레코드마다 프레임을 만들었을 때보다 줄어든 바이트
+
+        double AverageRecordsPerContainer() const {
+            return containers == 0 ? 0.0 : static_cast<double>(records) / containers;
+        }
+    };
+
+private:
+    StreamProtocol& protocol;
+    Sink sink;
+    Options options;
+    FrameBuffer buffer;
+    size_t pendingRecords = 0;
+    size_t pendingTagBytes = 0;
+    // 레코드가 하나뿐일 때 일반 프레임으로 풀기 위한 첫 레코드 정보
+    uint8_t firstType = 0;
+    uint16_t firstUser = 0;
+    size_t firstDataOffset = 0;
+    Clock::time_point deadline = Clock::time_point::max();
+    Metrics stats;
+
+    void emit();
+
+public:
+    ContainerBuilder(StreamProtocol& protocol, Sink sink, const Options& options);
+    ContainerBuilder(StreamProtocol& protocol, Sink sink);
+    /// 봉인된 프레임을 coalescer.enqueue() 로 넘깁니다. coalescer 는 빌더보다 오래 살아야 합니다.
+    ContainerBuilder(StreamProtocol& protocol, SendCoalescer& coalescer, const Options& options);
+
+    /// 레코드를 추가합니다. payloadType 은 0~15 중 CONTAINER 를 제외한 값, userField 는 10비트입니다.
+    /// 이 호출 안에서 프레임을 내보냈으면 true 를 반환합니다.
+    bool add(const uint8_t* data, size_t size, uint8_t payloadType = PayloadType::BINARY, uint16_t userField = 0,
+             Clock::time_point now = Clock::now());
+
+    /// 마감 시각이 지났으면 대기 중인 레코드를 내보냅니다.
+    bool poll(Clock::time_point now = Clock::now());
+    /// 대기 중인 레코드를 모두 내보냅니다.
+    void flush();
+
+    /// 대기 중인 레코드의 마감 시각입니다. 없으면 Clock::time_point::max().
+    Clock::time_point NextDeadline() const { return deadline; }
+    size_t PendingRecords() const { return pendingRecords; }
+    size_t PendingBytes() const { return buffer.PayloadSize(); }
+    const Metrics& GetMetrics() const { return stats; }
+
+    /// 레코드 하나가 컨테이너 안에서 차지하는 바이트 수입니다. (태그 + 길이 + 데이터)
+    static size_t RecordSize(size_t dataSize);
+};
+
+} // namespace streamprotocol
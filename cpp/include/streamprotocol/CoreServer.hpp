@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ParsedPacketView.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 코어마다 리스너, 이벤트 루프, 디코더, 버퍼 풀, 통계를 따로 두는 thread-per-core 서버 런타임입니다. (Linux 전용)
+///
+/// - 샤드마다 같은 포트에 SO_REUSEPORT 리스너를 열어, 커널이 새 연결을 샤드 사이에 나눕니다.
+///   연결은 받아 준 샤드에서 끝날 때까지 처리되며, 샤드 사이에는 잠금도 공유 큐도 없습니다.
+/// - 샤드 스레드는 지정한 CPU 에 고정된 뒤 샤드 객체(통계 포함), 버퍼 풀, 연결 표를 그 스레드에서 할당합니다.
+///   (리눅스의 first-touch 정책에 따라 해당 CPU 의 NUMA 노드 메모리에 놓입니다)
+/// - 핸들러는 start() 에서 HandlerFactory 로 샤드마다 하나씩 만들어지므로 핸들러 상태도 샤드 전용입니다.
+///   팩토리는 호출자 스레드에서 돌므로, 큰 상태는 핸들러 안에서 처음 쓸 때 할당하면 샤드의 노드에 놓입니다.
+///
+/// 통계는 샤드 스레드만 쓰고 다른 스레드는 Stats() 로 읽기만 합니다. (원자적 읽기, 잠금 없음)
+/// 핸들러는 예외를 던지면 안 됩니다. 샤드 스레드가 오류(epoll_wait 실패 등)로 끝나면 그 샤드의 리스너를 바로 닫아
+/// 새 연결이 남은 샤드로 가게 하고, 그 예외는 stop() 에서 다시 던집니다.
+class CoreServer {
+public:
+    class Shard;
+
+    struct Options {
+        std::string host;                       // 비어 있으면 모든 주소 (IPv4)
+        uint16_t port = 0;                      // 0 이면 임시 포트. start() 후 Port() 로 확인
+        size_t shards = 0;                      // 0 이면 cpus 개수, cpus 도 비어 있으면 hardware_concurrency()
+        std::vector<int> cpus;                  // 샤드 i 를 cpus[i % cpus.size()] 에 고정. 비어 있으면 i 번 CPU
+        bool pinThreads = true;
+        int backlog = 1024;
+        size_t readBufferSize = 64u * 1024u;    // 연결별 초기 수신 버퍼 (큰 프레임이 오면 그 크기까지 늘어남)
+        uint64_t maxPacketLength = 16u * 1024u * 1024u;
+        size_t maxOutputBuffer = 4u * 1024u * 1024u;   // 연결별 미전송 바이트 상한. 넘으면 send() 가 false
+        size_t pooledBuffers = 64;              // 샤드별로 재사용할 연결 버퍼 수
+    };
+
+    struct Handlers {
+        /// 검증된 프레임. frame 은 연결의 수신 버퍼를 가리키므로 호출 안에서만 유효합니다. (필수)
+        std::function<void(Shard& shard, int connection, const ParsedPacketView& frame)> onFrame;
+        std::function<void(Shard& shard, int connection)> onOpen;      // 선택
+        std::function<void(Shard& shard, int connection)> onClose;     // 선택
+    };
+    /// start() 를 호출한 스레드에서 샤드마다 한 번 호출되어 그 샤드의 핸들러를 만듭니다.
+    using HandlerFactory = std::function<Handlers(Shard& shard)>;
+
+    struct ShardStats {
+        uint64_t accepted = 0;
+        uint64_t closed = 0;
+        uint64_t frames = 0;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        uint64_t crcErrors = 0;         // CRC 불일치 프레임 (건너뛰고 계속 읽음)
+        uint64_t protocolErrors = 0;    // 헤더 오류로 끊은 연결
+    };
+
+    /// 샤드 하나입니다. 모든 메서드는 그 샤드의 스레드(핸들러 안)에서만 호출해야 합니다.
+    class Shard {
+    public:
+        struct Connection;
+
+    private:
+        struct Counters {
+            std::atomic<uint64_t> accepted{ 0 };
+            std::atomic<uint64_t> closed{ 0 };
+            std::atomic<uint64_t> frames{ 0 };
+            std::atomic<uint64_t> bytesIn{ 0 };
+            std::atomic<uint64_t> bytesOut{ 0 };
+            std::atomic<uint64_t> crcErrors{ 0 };
+            std::atomic<uint64_t> protocolErrors{ 0 };
+        };
+
+        const CoreServer& server;
+        size_t index;
+        int cpu;
+        int listener = -1;
+        int epollFd = -1;
+        int wakeFd = -1;
+        Handlers handlers;
+        std::vector<std::unique_ptr<Connection>> connections;   // fd 로 인덱싱
+        std::vector<std::vector<uint8_t>> bufferPool;
+        std::exception_ptr failure;                             // 샤드 스레드를 끝낸 예외 (join 후 읽음)
+        alignas(64) Counters counters;
+
+        friend class CoreServer;
+
+        void run();
+        void closeConnections();
+        void acceptAll();
+        void readFrom(int fd);
+        void flushOutput(int fd);
+        void closeDescriptors();
+        void closeFd(int fd);
+        bool dispatch(int fd, Connection& connection);
+        std::vector<uint8_t> takeBuffer();
+        void returnBuffer(std::vector<uint8_t>&& buffer);
+        void updateInterest(int fd, Connection& connection, bool wantWrite);
+
+    public:
+        Shard(const CoreServer& server, size_t index, int cpu);
+        ~Shard();
+
+        Shard(const Shard&) = delete;
+        Shard& operator=(const Shard&) = delete;
+
+        size_t Index() const { return index; }
+        /// 고정된 CPU 번호입니다. 고정하지 않았으면 -1.
+        int Cpu() const { return cpu; }
+        const StreamProtocol& Protocol() const { return server.protocol; }
+
+        /// 인코딩된 프레임을 연결로 보냅니다. 바로 쓰지 못한 부분은 연결별 출력 버퍼에 남겨 두었다가 이어서 씁니다.
+        /// 연결이 없거나, 밀린 출력과 이 프레임을 합해 출력 버퍼 상한을 넘으면 아무것도 쓰지 않고 false.
+        bool send(int connection, const uint8_t* frame, size_t size);
+        /// 연결을 닫습니다. onClose 가 호출됩니다.
+        void close(int connection);
+        size_t OpenConnections() const;
+    };
+
+private:
+    const StreamProtocol& protocol;
+    HandlerFactory factory;
+    Options options;
+    uint16_t boundPort = 0;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<std::thread> threads;
+    std::atomic<bool> running{ false };
+
+    struct Descriptors;
+    struct Startup;
+
+    int openListener(uint16_t port) const;
+    void shardThread(size_t index, int cpu, const Descriptors& descriptors, const std::shared_ptr<Startup>& startup);
+
+public:
+    CoreServer(const StreamProtocol& protocol, HandlerFactory factory, const Options& options);
+    CoreServer(const StreamProtocol& protocol, HandlerFactory factory);
+    ~CoreServer();
+
+    CoreServer(const CoreServer&) = delete;
+    CoreServer& operator=(const CoreServer&) = delete;
+
+    /// 리스너를 열고 샤드 스레드를 시작합니다. 바인드 실패 등은 std::system_error,
+    /// 팩토리가 onFrame 을 주지 않으면 std::invalid_argument 이며 팩토리가 던진 예외도 그대로 전달됩니다.
+    /// 실패하면 이미 띄운 샤드 스레드를 모두 거두고 리스너를 닫은 뒤 던집니다.
+    void start();
+    /// 모든 샤드를 멈추고 연결과 리스너를 닫은 뒤 스레드가 끝날 때까지 기다립니다. 통계는 계속 읽을 수 있습니다.
+    /// 오류로 먼저 끝난 샤드가 있으면 정리를 마친 뒤 그 예외(첫 번째)를 다시 던집니다.
+    void stop();
+
+    uint16_t Port() const { return boundPort; }
+    size_t Shards() const { return shards.size(); }
+    ShardStats Stats(size_t shard) const;
+    /// 모든 샤드 통계의 합입니다.
+    ShardStats TotalStats() const;
+};
+
+} // namespace streamprotocol
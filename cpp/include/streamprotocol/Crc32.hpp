@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace streamprotocol {
+
+/// 프레임 트레일러에 쓰는 CRC 를 나누어 계산하는 누산기입니다.
+/// update() 를 여러 번 나누어 호출해도 한 번에 compute() 한 결과와 같습니다.
+/// 소프트웨어 경로는 slice-by-8 표(16바이트 단위 처리)를 씁니다.
+///
+/// - Ieee       : CRC32 (다항식 0xEDB88320). protocolVersion 1 등 기본 체크섬.
+/// - Castagnoli : CRC32C (다항식 0x82F63B78). protocolVersion 2 의 체크섬으로,
+///                x86-64 SSE4.2 / ARMv8 CRC 명령이 있으면 하드웨어로 계산합니다.
+class Crc32 {
+public:
+    enum class Algorithm : uint8_t { Ieee, Castagnoli };
+
+private:
+    uint32_t state = 0xFFFFFFFFu;
+    Algorithm algorithm;
+
+    template <bool Copy>
+    static uint32_t run(uint32_t crc, Algorithm algorithm, uint8_t* dst, const uint8_t* src, size_t length);
+
+public:
+    explicit Crc32(Algorithm algorithm = Algorithm::Ieee) : algorithm(algorithm) {}
+    /// State() 로 저장해 둔 중간 상태에서 이어서 계산합니다.
+    Crc32(Algorithm algorithm, uint32_t state) : state(state), algorithm(algorithm) {}
+
+    void update(const uint8_t* data, size_t length);
+    /// src 를 dst 로 복사하면서 CRC 를 누적합니다. 원본을 한 번만 읽으므로 memcpy 후 update() 보다 빠릅니다.
+    /// (dst 와 src 는 겹치면 안 됩니다)
+    void copyUpdate(uint8_t* dst, const uint8_t* src, size_t length);
+    uint32_t value() const { return ~state; }
+    void reset() { state = 0xFFFFFFFFu; }
+    /// 최종 반전 전의 내부 레지스터 값입니다.
+    uint32_t State() const { return state; }
+    Algorithm GetAlgorithm() const { return algorithm; }
+
+    static uint32_t compute(const uint8_t* data, size_t length, Algorithm algorithm = Algorithm::Ieee);
+    /// 헤더의 protocolVersion 으로 트레일러 체크섬 알고리즘을 고릅니다.
+    static Algorithm ForVersion(uint8_t protocolVersion);
+    /// CRC32C 계산에 하드웨어 명령을 쓰는지 여부입니다.
+    static bool HardwareCastagnoli();
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ParsedPacketView.hpp"
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 같은 userField(채널)로 연달아 보내는 페이로드를 직전 페이로드와의 XOR 차분으로 보내는 인코더입니다.
+///
+/// 모든 출력은 PayloadType::DELTA 프레임이며, 페이로드 첫 바이트가 원래 payloadType(비트 0-3)과
+/// 키프레임 여부(비트 4)를 담습니다. (비트 5-7 예약, 0)
+///   키프레임: [ 플래그 ][ 원본 페이로드 ]
+///   차분:     [ 플래그 ][ 새 길이 (LEB128) ]{ [ 건너뛸 바이트 (LEB128) ][ 리터럴 길이 (LEB128) ][ XOR 바이트 ] }*
+/// 차분은 직전 페이로드(새 길이보다 짧으면 뒤를 0 으로 본 것)와 XOR 한 값이 0 인 구간을 건너뛰고,
+/// 나머지 구간만 리터럴로 담습니다. 마지막 리터럴 뒤의 0 구간은 생략합니다.
+///
+/// 채널마다 keyframeInterval 프레임에 한 번, 그리고 차분이 원본보다 크지 않으면 키프레임을 보냅니다.
+/// 수신 측(DeltaDecoder)이 채널의 모든 DELTA 프레임을 순서대로 받아야 하므로 순서를 보장하는 전송에서만 써야 하며,
+/// 재연결 뒤에는 forceKeyframe() 으로 기준을 다시 맞춥니다. 인스턴스는 한 스레드에서만 사용해야 합니다.
+class DeltaEncoder {
+public:
+    static constexpr size_t CHANNELS = 1024;        // userField 10비트
+    static constexpr uint8_t KEYFRAME_FLAG = 0x10;
+
+    struct Options {
+        uint32_t keyframeInterval = 64;     // 채널별 키프레임 주기 (프레임 수). 0 이면 첫 프레임과 대체 시에만
+    };
+
+    struct Metrics {
+        uint64_t keyframes = 0;
+        uint64_t deltas = 0;
+        uint64_t fallbackKeyframes = 0;     // 차분이 원본보다 커서 키프레임으로 보낸 횟수 (keyframes 에 포함)
+        uint64_t inputBytes = 0;            // 원본 페이로드 합
+        uint64_t outputBytes = 0;           // DELTA 프레임 페이로드 합
+
+        double Ratio() const { return inputBytes == 0 ? 1.0 : static_cast<double>(outputBytes) / inputBytes; }
+    };
+
+private:
+    struct Channel {
+        std::vector<uint8_t> previous;
+        uint32_t sinceKeyframe = 0;
+        bool valid = false;
+    };
+
+    StreamProtocol& protocol;
+    Options options;
+    std::vector<Channel> channels;
+    Metrics stats;
+
+    size_t writeDelta(const Channel& channel, const uint8_t* data, size_t size, uint8_t* out, size_t capacity) const;
+
+public:
+    DeltaEncoder(StreamProtocol& protocol, const Options& options);
+    explicit DeltaEncoder(StreamProtocol& protocol);
+
+    /// 페이로드를 channel(userField) 의 DELTA 프레임으로 인코딩합니다. payloadType 은 0~15 중 DELTA 가 아닌 값입니다.
+    std::vector<uint8_t> encode(const uint8_t* data, size_t size, uint8_t payloadType, uint16_t channel);
+
+    /// 다음 프레임을 키프레임으로 보냅니다. (수신 측 재시작/재연결 시)
+    void forceKeyframe(uint16_t channel);
+    void forceKeyframeAll();
+
+    const Metrics& GetMetrics() const { return stats; }
+};
+
+/// DeltaDecoder 가 복원한 페이로드입니다. data 는 디코더의 채널 버퍼를 가리키며 같은 채널의 다음 프레임까지 유효합니다.
+struct DeltaPayload {
+    uint8_t payloadType = 0;
+    uint16_t channel = 0;
+    bool keyframe = false;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+/// DeltaEncoder 가 만든 DELTA 프레임에서 원본 페이로드를 복원합니다.
+///
+/// 채널마다 직전 페이로드 버퍼를 하나 두고 그 자리에서 리터럴 구간만 XOR 하므로,
+/// 복원 비용은 바뀐 바이트 수에 비례하고 추가 할당이 없습니다. (페이로드가 커질 때만 버퍼를 늘림)
+/// 키프레임 전에 온 차분이나 잘못된 차분은 PacketException 이며, 그 채널은 다음 키프레임까지 차분을 거부합니다.
+/// 인스턴스는 한 스레드에서만 사용해야 합니다.
+class DeltaDecoder {
+public:
+    struct Options {
+        size_t maxPayloadSize = 16u * 1024u * 1024u;    // 복원 페이로드 크기 상한 (차분의 새 길이도 이 값으로 검사)
+    };
+
+private:
+    struct Channel {
+        std::vector<uint8_t> current;   // 직전 페이로드 (줄어든 뒤 다시 늘면 뒤쪽은 0 으로 채워짐)
+        bool valid = false;
+    };
+
+    Options options;
+    std::vector<Channel> channels;
+
+    void applyDelta(Channel& channel, const uint8_t* delta, size_t size);
+
+public:
+    explicit DeltaDecoder(const Options& options);
+    DeltaDecoder();
+
+    /// frame 이 DELTA 프레임이면 복원해 out 에 채우고 true, 아니면 아무것도 하지 않고 false.
+    bool decode(const ParsedPacketView& frame, DeltaPayload& out);
+    /// DELTA 프레임의 페이로드와 userField 로 복원합니다.
+    DeltaPayload decode(const uint8_t* payload, size_t size, uint16_t channel);
+
+    /// 채널의 기준 페이로드를 버립니다. 다음 키프레임까지 차분을 거부합니다.
+    void reset(uint16_t channel);
+    void resetAll();
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 같은 바이트로 반복해서 보내는 프레임(하트비트, ack, 상태 핑 등)을 한 번만 인코딩해 공유하는 캐시입니다.
+///
+/// get() 은 (페이로드, payloadType, fragFlag, userField, 프로토콜 버전)이 같으면 이전에 만든
+/// 불변 프레임을 그대로 돌려주고, 없으면 인코딩해 넣습니다. 항목 수와 바이트 수 한도를 넘으면
+/// 가장 오래 쓰지 않은 항목부터 내보냅니다. 돌려준 프레임은 캐시에서 빠진 뒤에도 유효합니다.
+/// 내부 잠금으로 보호되므로 여러 스레드가 하나의 캐시를 공유할 수 있습니다.
+class EncodedFrameCache {
+public:
+    using Frame = std::shared_ptr<const std::vector<uint8_t>>;
+
+    struct Options {
+        size_t maxEntries = 1024;
+        size_t maxBytes = 1024u * 1024u;    // 캐시된 프레임 바이트 합계 한도 (이보다 큰 프레임은 캐시하지 않음)
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+private:
+    struct Entry {
+        size_t hash;
+        Frame frame;
+    };
+    using EntryList = std::list<Entry>;
+
+    const StreamProtocol& protocol;
+    Options options;
+    mutable std::mutex mutex;
+    EntryList entries;                                             // 앞쪽이 최근에 쓴 항목
+    std::unordered_multimap<size_t, EntryList::iterator> index;
+    size_t bytes = 0;
+    Stats stats;
+
+    void evictFor(size_t incoming);
+
+public:
+    explicit EncodedFrameCache(const StreamProtocol& protocol);
+    EncodedFrameCache(const StreamProtocol& protocol, const Options& options);
+
+    /// 캐시된 프레임을 돌려주거나, 없으면 인코딩해 캐시에 넣고 돌려줍니다.
+    Frame get(const uint8_t* data, size_t size, uint8_t payloadType,
+              uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+    Frame get(const std::vector<uint8_t>& payload, uint8_t payloadType,
+              uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00) {
+        return get(payload.data(), payload.size(), payloadType, fragFlag, userValue);
+    }
+
+    void clear();
+    size_t Entries() const;
+    size_t Bytes() const;
+    Stats GetStats() const;
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Crc32.hpp"
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 파일 영역을 페이로드로 하는 프레임을 사용자 공간 복사 없이 보냅니다. (Linux 전용)
+///
+/// CRC 는 파일 영역을 mmap 해서 한 번 읽어 계산하고, 전송은 헤더 -> sendfile(페이로드) -> CRC 트레일러 순서입니다.
+/// 페이로드 바이트는 송신 경로에서 사용자 공간 버퍼를 거치지 않습니다.
+/// sendfile 을 쓸 수 없는 fd 조합이면 pread/write 로 자동 전환합니다.
+///
+/// CRC 계산과 전송 사이에 파일 내용이 바뀌면 상대편에서 CRC 검증이 실패합니다.
+/// 보내는 동안 해당 영역이 바뀌지 않음을 호출자가 보장해야 합니다.
+class FileFrameSender {
+public:
+    static constexpr size_t DEFAULT_MAP_WINDOW = 64u * 1024u * 1024u;
+
+private:
+    const StreamProtocol& protocol;
+    size_t mapWindow;
+    bool useSendfile;
+
+    void updateCrc(Crc32& crc, int fileFd, uint64_t offset, uint64_t length) const;
+
+public:
+    /// mapWindow: CRC 계산 시 한 번에 mmap 하는 크기입니다. (주소 공간 사용량 상한)
+    /// useSendfile: false 면 처음부터 pread/write 경로를 씁니다. (두 경로 비교 측정, sendfile 이 느린 fd 등)
+    explicit FileFrameSender(const StreamProtocol& protocol, size_t mapWindow = DEFAULT_MAP_WINDOW, bool useSendfile = true);
+
+    /// fileFd 의 [offset, offset + length) 영역을 하나의 프레임으로 outFd 에 보냅니다.
+    /// outFd 는 블로킹 fd 여야 하며, 프레임 전체 길이를 반환합니다. 실패 시 std::system_error.
+    uint64_t send(int outFd, int fileFd, uint64_t offset, uint64_t length, uint8_t payloadType = PayloadType::BINARY,
+                  uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00) const;
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 헤더 자리(headroom 8바이트)와 CRC 자리(tailroom 4바이트)를 미리 비워 둔 페이로드 버퍼입니다.
+///
+/// 애플리케이션이 Payload() 에 바로 페이로드를 채우고 StreamProtocol::toBytes(FrameBuffer&&, ...) 를 부르면
+/// 헤더와 CRC 만 기존 저장 공간 앞뒤에 기록하고 그 저장 공간을 그대로 프레임으로 넘깁니다. (페이로드 복사 없음)
+/// 전송이 끝난 프레임 벡터를 FrameBuffer(std::move(frame)) 로 되돌려 받으면 할당된 용량을 재사용할 수 있습니다.
+class FrameBuffer {
+private:
+    std::vector<uint8_t> storage;   // [headroom][payload][tailroom], 항상 FRAME_OVERHEAD 이상
+
+    friend class StreamProtocol;
+
+public:
+    explicit FrameBuffer(size_t payloadCapacity = 0) {
+        storage.reserve(StreamProtocol::FRAME_OVERHEAD + payloadCapacity);
+        storage.resize(StreamProtocol::FRAME_OVERHEAD);
+    }
+
+    /// 기존 벡터의 용량을 넘겨받아 빈 페이로드로 시작합니다. (이전 내용은 버려짐)
+    explicit FrameBuffer(std::vector<uint8_t>&& reuse) : storage(std::move(reuse)) {
+        storage.assign(StreamProtocol::FRAME_OVERHEAD, 0);  // 이전 바이트가 이후 resize() 로 드러나지 않게 비웁니다.
+    }
+
+    uint8_t* Payload() { return storage.data() + StreamProtocol::HEADER_SIZE; }
+    const uint8_t* Payload() const { return storage.data() + StreamProtocol::HEADER_SIZE; }
+    size_t PayloadSize() const { return storage.size() - StreamProtocol::FRAME_OVERHEAD; }
+    size_t PayloadCapacity() const { return storage.capacity() - StreamProtocol::FRAME_OVERHEAD; }
+
+    void reserve(size_t payloadCapacity) { storage.reserve(StreamProtocol::FRAME_OVERHEAD + payloadCapacity); }
+    /// 페이로드 길이를 바꿉니다. 늘어난 부분은 0 으로 채워집니다.
+    void resize(size_t payloadSize) { storage.resize(StreamProtocol::FRAME_OVERHEAD + payloadSize); }
+    void clear() { storage.resize(StreamProtocol::FRAME_OVERHEAD); }
+
+    void append(const uint8_t* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (data == nullptr) {
+            throw std::invalid_argument("payload must not be null");
+        }
+        size_t offset = PayloadSize();
+        resize(offset + size);
+        std::memcpy(Payload() + offset, data, size);
+    }
+};
+
+} // namespace streamprotocol
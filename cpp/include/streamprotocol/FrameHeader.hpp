@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace streamprotocol {
+
+/// 8바이트 헤더만 디코딩한 결과입니다. (StreamProtocol::decodeHeader)
+/// 페이로드와 CRC 는 아직 확인되지 않은 상태입니다.
+struct FrameHeader {
+    uint8_t protocolVersion = 0;
+    uint64_t packetLength = 0;      // 헤더 + 페이로드 + CRC 전체 길이
+    uint8_t fragmentFlag = 0;
+    uint8_t payloadType = 0;
+    uint16_t userField = 0;
+
+    uint64_t PayloadSize() const { return packetLength - 8 - sizeof(uint32_t); }
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "Crc32.hpp"
+#include "FrameHeader.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 큰 프레임을 버퍼링하지 않고 받는 스트리밍 디코더입니다.
+///
+/// 연결에서 읽은 바이트를 순서대로 feed() 에 넣으면, 헤더 8바이트가 모인 시점에 onHeader 가,
+/// 페이로드가 도착하는 대로 최대 maxChunkSize 바이트 단위로 onPayload 가 호출됩니다.
+/// 페이로드 조각은 feed() 에 넘긴 버퍼를 그대로 가리키며(복사 없음), CRC 는 도착과 동시에 누적됩니다.
+/// onPayload 로 전달된 데이터는 트레일러가 도착해 onEnd(header, crcValid) 가 호출되기 전까지 검증되지 않은 상태입니다.
+///
+/// 내부 버퍼는 헤더/트레일러용 12바이트뿐이므로 메모리 사용량은 프레임 크기와 무관합니다.
+/// CRC 불일치는 onEnd 로 보고하고 다음 프레임을 계속 읽습니다. (프레임 경계는 길이로 유지됨)
+/// 헤더가 잘못되면 PacketException 을 던지며, 이후 스트림 경계를 신뢰할 수 없으므로 연결을 끊어야 합니다.
+class FrameReader {
+public:
+    struct Callbacks {
+        std::function<void(const FrameHeader&)> onHeader;                                 // 선택
+        std::function<void(const FrameHeader&, const uint8_t*, size_t)> onPayload;        // 필수, 미검증 데이터
+        std::function<void(const FrameHeader&, bool crcValid)> onEnd;                     // 필수
+    };
+
+    static constexpr size_t DEFAULT_MAX_CHUNK_SIZE = 64u * 1024u;
+
+private:
+    enum class State { Header, Payload, Trailer };
+
+    const StreamProtocol& protocol;
+    Callbacks callbacks;
+    size_t maxChunkSize;
+    uint64_t maxPacketLength = StreamProtocol::MAX_PACKET_LENGTH;
+
+    State state = State::Header;
+    uint8_t scratch[StreamProtocol::HEADER_SIZE];
+    size_t scratchSize = 0;
+    FrameHeader header;
+    uint64_t payloadRemaining = 0;
+    Crc32 crc;
+
+    void startFrame();
+    void endFrame();
+
+public:
+    FrameReader(const StreamProtocol& protocol, Callbacks callbacks, size_t maxChunkSize = DEFAULT_MAX_CHUNK_SIZE);
+
+    /// 헤더가 선언한 프레임 길이의 상한입니다. 넘으면 페이로드를 읽기 전에 PayloadTooLargeException.
+    void SetMaxPacketLength(uint64_t length) { maxPacketLength = length; }
+
+    /// 연결에서 읽은 바이트를 넣습니다. 콜백은 이 호출 안에서 실행됩니다.
+    void feed(const uint8_t* data, size_t size);
+
+    /// 프레임 중간(헤더 일부 포함)에 있는지 여부입니다. 연결 종료 시 true 면 프레임이 잘린 것입니다.
+    bool InFrame() const { return state != State::Header || scratchSize != 0; }
+    /// 현재 프레임에서 아직 받지 않은 페이로드 바이트 수입니다.
+    uint64_t PayloadRemaining() const { return payloadRemaining; }
+    /// 현재(또는 마지막) 프레임의 헤더입니다.
+    const FrameHeader& CurrentHeader() const { return header; }
+};
+
+} // namespace streamprotocol
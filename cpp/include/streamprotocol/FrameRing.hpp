@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "ParsedPacketView.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/// 링의 생산자/소비자 위치입니다. 서로 다른 캐시 라인에 두어 false sharing 을 막습니다.
+/// 공유 메모리 위에 그대로 올릴 수 있도록 표준 레이아웃만 사용합니다.
+struct FrameRingControl {
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{ 0 };   // 생산자 예약 위치 (누적 바이트)
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail{ 0 };   // 소비자 해제 위치 (누적 바이트)
+};
+
+/// 생산자가 예약한 레코드 슬롯입니다. Payload() 에 페이로드를 직접 쓴 뒤 commit() 합니다.
+class FrameSlot {
+private:
+    template <bool> friend class BasicFrameRing;
+
+    uint8_t* record = nullptr;
+    size_t frameSize = 0;
+
+public:
+    explicit operator bool() const { return record != nullptr; }
+    uint8_t* Payload() const { return record + sizeof(uint64_t) + StreamProtocol::HEADER_SIZE; }
+    size_t PayloadSize() const { return frameSize - StreamProtocol::FRAME_OVERHEAD; }
+    /// 헤더부터 CRC 까지 포함한 프레임 영역입니다. (commitFrame 용)
+    uint8_t* Frame() const { return record + sizeof(uint64_t); }
+    size_t FrameSize() const { return frameSize; }
+};
+
+/// 인코딩된 StreamProtocol 프레임을 가변 길이 레코드로 그대로 저장하는 lock-free 링 버퍼입니다.
+///
+/// 레코드 레이아웃: [ 8바이트 레코드 워드 ][ 프레임 ][ 8바이트 정렬 패딩 ]
+/// 레코드 워드가 0 이면 아직 커밋되지 않은 것이며, 소비자는 해제한 영역을 0 으로 되돌려
+/// 다음 바퀴의 레코드 워드가 항상 0 에서 시작하도록 보장합니다.
+///
+/// MultiProducer == false 이면 단일 생산자(SPSC), true 이면 CAS 로 예약하는 다중 생산자(MPSC)입니다.
+/// 소비자는 항상 하나여야 합니다. MPSC 에서는 예약 순서대로 소비되므로,
+/// 예약 후 커밋하지 않는 생산자가 있으면 소비가 멈춥니다. (포기하려면 cancel())
+template <bool MultiProducer>
+class BasicFrameRing {
+private:
+    struct AlignedDelete {
+        void operator()(uint8_t* p) const { ::operator delete[](p, std::align_val_t(CACHE_LINE_SIZE)); }
+    };
+
+    std::unique_ptr<FrameRingControl> ownedControl;
+    std::unique_ptr<uint8_t[], AlignedDelete> ownedData;
+
+    FrameRingControl* control;
+    uint8_t* data;
+    size_t capacity;
+    uint64_t mask;
+    StreamProtocol protocol;
+
+    alignas(CACHE_LINE_SIZE) uint64_t cachedTail = 0;     // 생산자 전용 (SPSC)
+    alignas(CACHE_LINE_SIZE) uint64_t pendingSpan = 0;    // 소비자 전용
+
+    std::atomic<uint64_t>& wordAt(uint64_t position) const;
+    uint8_t* reserveRecord(size_t frameSize);
+    void publish(const FrameSlot& slot, uint64_t word);
+
+public:
+    /// capacity 바이트(2의 거듭제곱, 최소 64)의 링을 할당합니다.
+    explicit BasicFrameRing(size_t capacity, const StreamProtocol& protocol = StreamProtocol());
+    /// 외부 메모리(예: 공유 메모리) 위에 링을 붙입니다. data 는 0 으로 초기화되어 있어야 합니다.
+    BasicFrameRing(FrameRingControl* control, uint8_t* data, size_t capacity, const StreamProtocol& protocol = StreamProtocol());
+
+    BasicFrameRing(const BasicFrameRing&) = delete;
+    BasicFrameRing& operator=(const BasicFrameRing&) = delete;
+
+    size_t Capacity() const { return capacity; }
+    /// 한 레코드로 넣을 수 있는 최대 페이로드 크기입니다.
+    /// 링 끝의 패딩과 레코드가 항상 함께 들어갈 수 있도록 레코드는 용량의 절반으로 제한됩니다.
+    size_t MaxPayloadSize() const { return capacity / 2 - sizeof(uint64_t) - StreamProtocol::FRAME_OVERHEAD; }
+
+    // ---- 생산자 ----
+
+    /// payloadSize 바이트 페이로드용 슬롯을 예약합니다. 공간이 없으면 빈 슬롯을 반환합니다.
+    FrameSlot tryReserve(size_t payloadSize);
+    /// 슬롯의 페이로드 앞뒤에 헤더와 CRC 를 기록하고 소비자에게 공개합니다.
+    void commit(FrameSlot& slot, uint8_t payloadType, uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+    /// Frame() 에 이미 완성된 프레임을 쓴 경우, 헤더/CRC 를 건드리지 않고 공개합니다.
+    void commitFrame(FrameSlot& slot);
+    /// 예약을 포기합니다. 소비자는 이 레코드를 건너뜁니다.
+    void cancel(FrameSlot& slot);
+
+    /// 예약 + 복사 + 커밋을 한 번에 수행합니다. 공간이 없으면 false.
+    bool tryWrite(const uint8_t* payload, size_t size, uint8_t payloadType,
+                  uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+    /// 이미 인코딩된 프레임(예: 소켓에서 받은 바이트)을 그대로 넣습니다. 공간이 없으면 false.
+    bool tryWriteFrame(const uint8_t* frame, size_t size);
+
+    // ---- 소비자 ----
+
+    /// 다음 프레임을 그대로 엿봅니다. 처리 후 반드시 release() 해야 합니다.
+    bool tryPeekFrame(const uint8_t*& frame, size_t& size);
+    /// 다음 프레임을 검증(CRC 포함)하여 링 내부를 가리키는 뷰로 돌려줍니다.
+    /// 검증에 실패하면 PacketException 을 던지며, 해당 레코드는 release() 로 건너뛸 수 있습니다.
+    bool tryRead(ParsedPacketView& view);
+    /// 마지막으로 읽은 레코드를 해제합니다.
+    void release();
+};
+
+using SpscFrameRing = BasicFrameRing<false>;
+using MpscFrameRing = BasicFrameRing<true>;
+
+} // namespace streamprotocol
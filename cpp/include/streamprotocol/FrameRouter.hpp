@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "FrameHeader.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 8바이트 헤더만 읽고 userField / payloadType 으로 대상 연결을 골라 프레임을 그대로 넘기는 라우터입니다.
+///
+/// 페이로드를 파싱하거나 다시 인코딩하지 않으므로 원본 CRC 가 그대로 전달됩니다. (verifyCrc 로 검증 가능)
+/// 경로는 userField 경로 -> payloadType 경로 -> 기본 경로 순으로 찾고, 어디에도 없으면 프레임을 버립니다.
+/// 대상은 정수 식별자이며, route() 에서는 핸들러에 그대로 전달되고 forward() (Linux) 에서는 출력 fd 로 쓰입니다.
+/// 경로 표 변경과 전달은 한 스레드에서 해야 합니다.
+class FrameRouter {
+public:
+    static constexpr int NO_ROUTE = -1;
+
+    struct Options {
+        bool verifyCrc = false;                                   // route() 에서 CRC 를 확인하고 틀린 프레임은 버림
+        size_t maxPacketLength = StreamProtocol::MAX_PACKET_LENGTH;
+    };
+
+    struct Stats {
+        uint64_t framesForwarded = 0;
+        uint64_t bytesForwarded = 0;
+        uint64_t framesDropped = 0;     // 경로 없음
+        uint64_t crcErrors = 0;
+    };
+
+    /// route() 가 찾은 대상과 원본 프레임 바이트(헤더 ~ CRC)를 받습니다. 포인터는 호출 동안만 유효합니다.
+    using Handler = std::function<void(int target, const uint8_t* frame, size_t size)>;
+
+private:
+    const StreamProtocol& protocol;
+    Options options;
+    std::vector<int> userRoutes;
+    std::array<int, 16> typeRoutes;
+    int defaultRoute = NO_ROUTE;
+    Stats stats;
+#if defined(__linux__)
+    int pipeFds[2] = { -1, -1 };
+    std::vector<uint8_t> scratch;
+#endif
+
+    FrameHeader checkedHeader(const uint8_t* header) const;
+
+public:
+    explicit FrameRouter(const StreamProtocol& protocol);
+    FrameRouter(const StreamProtocol& protocol, const Options& options);
+    ~FrameRouter();
+    FrameRouter(const FrameRouter&) = delete;
+    FrameRouter& operator=(const FrameRouter&) = delete;
+
+    /// 대상에 NO_ROUTE 를 주면 해당 경로를 지웁니다.
+    void SetUserRoute(uint16_t userField, int target);
+    void SetTypeRoute(uint8_t payloadType, int target);
+    void SetDefaultRoute(int target) { defaultRoute = target; }
+
+    /// 헤더에 해당하는 대상입니다. 경로가 없으면 NO_ROUTE.
+    int Lookup(const FrameHeader& header) const;
+
+    /// data 안의 완성된 프레임들을 handler 로 넘기고 소비한 바이트 수를 반환합니다.
+    /// 끝에 남은 불완전한 프레임은 소비하지 않으므로 호출자가 다음 데이터와 이어 붙여 다시 넘깁니다.
+    /// 헤더가 잘못되었거나 maxPacketLength 를 넘으면 PacketException.
+    size_t route(const uint8_t* data, size_t size, const Handler& handler);
+
+#if defined(__linux__)
+    /// inFd 에서 프레임 하나를 읽어 대상 fd 로 넘깁니다. 헤더만 사용자 공간으로 읽고, 나머지(페이로드 + CRC)는
+    /// splice 로 커널 안에서 옮깁니다. (splice 를 쓸 수 없는 fd 면 read/write 로 전환)
+    /// CRC 는 검증하지 않고 그대로 전달합니다. 프레임 경계에서 EOF 면 false, 프레임 중간이면 PacketException.
+    bool forward(int inFd);
+#endif
+
+    const Stats& GetStats() const { return stats; }
+};
+
+} // namespace streamprotocol
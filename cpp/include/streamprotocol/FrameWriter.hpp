@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "Crc32.hpp"
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 페이로드 전체를 메모리에 올리지 않고 프레임 하나를 스트리밍으로 인코딩합니다.
+///
+/// begin() 에서 선언한 길이로 헤더를 먼저 내보내고, 페이로드는 메모리 / std::istream / fd 에서
+/// 조각 단위로 받아 그대로 싱크에 넘기면서 CRC 를 누적합니다. finish() 가 CRC 트레일러를 붙입니다.
+/// 메모리 사용량은 프레임 크기와 무관하게 chunkSize 로 고정됩니다.
+///
+/// 선언한 길이를 넘겨 쓰거나(overrun) 덜 쓰고 finish() 하면(underrun) PacketException 을 던집니다.
+/// underrun 은 이미 헤더가 나간 뒤이므로 연결을 끊어야 합니다.
+class FrameWriter {
+public:
+    /// 인코딩된 바이트를 받아 쓰는 함수입니다. 넘겨받은 바이트를 모두 쓰고 반환해야 합니다.
+    using Sink = std::function<void(const uint8_t*, size_t)>;
+
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64u * 1024u;
+
+private:
+    const StreamProtocol& protocol;
+    Sink sink;
+    std::vector<uint8_t> chunk;
+    Crc32 crc;
+    uint64_t remaining = 0;
+    uint64_t frameLength = 0;
+    bool inFrame = false;
+
+    void requireFrame() const;
+
+public:
+    FrameWriter(const StreamProtocol& protocol, Sink sink, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /// payloadSize 바이트짜리 프레임을 시작하고 헤더를 싱크로 내보냅니다.
+    void begin(uint64_t payloadSize, uint8_t payloadType = PayloadType::BINARY,
+               uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+
+    /// 페이로드 조각을 씁니다. (복사 없이 싱크로 전달)
+    void write(const uint8_t* data, size_t size);
+    /// in 에서 최대 maxBytes(기본: 남은 길이 전부)를 읽어 씁니다. 실제로 쓴 바이트 수를 반환하며,
+    /// 스트림이 먼저 끝나면 더 적을 수 있습니다.
+    uint64_t writeFrom(std::istream& in, uint64_t maxBytes = UINT64_MAX);
+#if defined(__unix__) || defined(__APPLE__)
+    /// fd 에서 read() 로 최대 maxBytes 를 읽어 씁니다. EOF 에서 멈추며, 읽기 실패 시 std::system_error.
+    uint64_t writeFromFd(int fd, uint64_t maxBytes = UINT64_MAX);
+#endif
+
+    /// CRC 트레일러를 내보내고 프레임을 닫습니다. 프레임 전체 길이를 반환합니다.
+    uint64_t finish();
+
+    bool InFrame() const { return inFrame; }
+    /// 선언한 길이 중 아직 쓰지 않은 페이로드 바이트 수입니다.
+    uint64_t Remaining() const { return remaining; }
+
+    static Sink StreamSink(std::ostream& out);
+#if defined(__unix__) || defined(__APPLE__)
+    /// 블로킹 fd 에 write() 로 쓰는 싱크입니다. (부분 쓰기/EINTR 처리, 실패 시 std::system_error)
+    static Sink FdSink(int fd);
+#endif
+};
+
+} // namespace streamprotocol
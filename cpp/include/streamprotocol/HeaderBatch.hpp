@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "FrameHeader.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// decodeHeaderColumns() 의 출력 배열들입니다. 각 배열은 count 개 이상의 원소를 담을 수 있어야 합니다.
+/// valid[i] 는 packetLength 가 [12, maxPacketLength] 범위이면 1, 아니면 0 입니다.
+struct HeaderColumns {
+    uint8_t* protocolVersion;
+    uint64_t* packetLength;
+    uint8_t* fragmentFlag;
+    uint8_t* payloadType;
+    uint16_t* userField;
+    uint8_t* valid;
+};
+
+/// base + offsets[i] 위치의 헤더 count 개를 필드별 배열(SoA)로 디코딩하고, 범위를 벗어난 헤더 수를 반환합니다.
+/// 각 위치에서 8바이트를 읽을 수 있어야 합니다. 페이로드와 CRC 는 확인하지 않습니다.
+/// x86-64 에서는 실행 시 AVX2 지원 여부를 확인해 4개씩, AArch64 에서는 NEON 으로 2개씩 처리하고 나머지는 스칼라로 처리합니다.
+size_t decodeHeaderColumns(const uint8_t* base, const uint64_t* offsets, size_t count, const HeaderColumns& out,
+                           uint64_t maxPacketLength = StreamProtocol::MAX_PACKET_LENGTH);
+
+/// 현재 CPU 에서 decodeHeaderColumns() 가 사용하는 구현 이름입니다. ("avx2", "neon", "scalar")
+const char* headerDecoderImplementation();
+
+/// 캡처 분석이나 라우팅처럼 헤더 필드만 필요한 경우를 위한 일괄 헤더 디코더입니다.
+/// decode() 할 때마다 내부 배열을 재사용합니다.
+class HeaderBatch {
+private:
+    std::vector<uint8_t> protocolVersions;
+    std::vector<uint64_t> packetLengths;
+    std::vector<uint8_t> fragmentFlags;
+    std::vector<uint8_t> payloadTypes;
+    std::vector<uint16_t> userFields;
+    std::vector<uint8_t> valid;
+    size_t size = 0;
+    size_t invalidCount = 0;
+
+public:
+    /// 헤더 count 개를 디코딩하고 범위를 벗어난 헤더 수를 반환합니다.
+    size_t decode(const uint8_t* base, const uint64_t* offsets, size_t count,
+                  uint64_t maxPacketLength = StreamProtocol::MAX_PACKET_LENGTH);
+
+    size_t Size() const { return size; }
+    size_t InvalidCount() const { return invalidCount; }
+
+    const uint8_t* ProtocolVersions() const { return protocolVersions.data(); }
+    const uint64_t* PacketLengths() const { return packetLengths.data(); }
+    const uint8_t* FragmentFlags() const { return fragmentFlags.data(); }
+    const uint8_t* PayloadTypes() const { return payloadTypes.data(); }
+    const uint16_t* UserFields() const { return userFields.data(); }
+    const uint8_t* Valid() const { return valid.data(); }
+
+    FrameHeader at(size_t index) const;
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Crc32.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// version / fragFlag / payloadType / userField 가 고정된 프레임을 반복해서 인코딩하기 위한 헤더 템플릿입니다.
+///
+/// 생성 시 필드를 한 번만 검증해 헤더 비트를 미리 묶어 두고, 길이 필드를 0 으로 둔 헤더 8바이트를
+/// 통과한 CRC 상태도 저장합니다. CRC 는 입력에 대해 선형이므로 송신마다 길이 비트의 기여분만
+/// 표에서 XOR 하면 헤더 뒤 CRC 상태가 나오고, 남은 일은 페이로드 CRC 뿐입니다.
+/// 템플릿은 만든 뒤 바뀌지 않으므로 여러 스레드에서 동시에 써도 됩니다.
+class HeaderTemplate {
+private:
+    uint64_t fixedBits;         // 길이 필드(비트 4-48)를 뺀 헤더 값
+    uint32_t baseState;         // 길이 0 헤더를 통과한 CRC 내부 상태
+    Crc32::Algorithm algorithm;
+
+    uint32_t stateFor(uint64_t lengthBits) const;
+
+public:
+    HeaderTemplate(const StreamProtocol& protocol, uint8_t payloadType,
+                   uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+
+    /// payloadSize 에 맞는 헤더 8바이트를 씁니다. 너무 크면 PayloadTooLargeException.
+    void writeHeader(uint8_t* header, size_t payloadSize) const;
+    /// payloadSize 길이의 헤더를 이미 통과한 CRC 누산기를 돌려줍니다. 이어서 페이로드만 update() 하면 됩니다.
+    Crc32 crcAfterHeader(size_t payloadSize) const;
+
+    /// out 에 프레임 전체를 쓰고 프레임 길이를 반환합니다. capacity 가 모자라면 std::invalid_argument.
+    size_t encodeInto(const uint8_t* data, size_t size, uint8_t* out, size_t capacity) const;
+    std::vector<uint8_t> encode(const uint8_t* data, size_t size) const;
+
+    uint8_t ProtocolVersion() const { return static_cast<uint8_t>(fixedBits & 0x0Fu); }
+    uint8_t FragmentFlag() const { return static_cast<uint8_t>((fixedBits >> 49) & 0x01u); }
+    uint8_t PayloadType() const { return static_cast<uint8_t>((fixedBits >> 50) & 0x0Fu); }
+    uint16_t UserField() const { return static_cast<uint16_t>((fixedBits >> 54) & 0x3FFu); }
+};
+
+} // namespace streamprotocol
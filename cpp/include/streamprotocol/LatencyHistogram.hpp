@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace streamprotocol {
+
+/// HDR 방식(로그 구간 + 구간당 128개 선형 하위 구간)의 지연 히스토그램입니다.
+/// 첫 구간 뒤로는 앞 절반이 이전 구간과 겹치므로, 구간마다 새로 쓰이는 하위 구간은 위쪽 64개입니다.
+/// 0 ~ 2^63 ns 범위를 상대 오차 약 1.6% 이내로 기록하며, 기록은 O(1) 이고 메모리는 약 30KB 로 고정입니다.
+/// 스레드 안전하지 않으므로 스레드별로 기록한 뒤 merge() 로 합칩니다.
+class LatencyHistogram {
+private:
+    static constexpr unsigned SUB_BUCKET_BITS = 7;                          // 128 개의 하위 구간
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ull << SUB_BUCKET_BITS;
+    static constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+    long double sum = 0;
+
+    static size_t indexOf(uint64_t value);
+    static uint64_t highestEquivalentValue(size_t index);
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t valueNs);
+    void recordMany(uint64_t valueNs, uint64_t count);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t Count() const { return total; }
+    uint64_t Min() const { return total == 0 ? 0 : minValue; }
+    uint64_t Max() const { return maxValue; }
+    double Mean() const { return total == 0 ? 0.0 : static_cast<double>(sum / total); }
+    /// percentile(0~100) 위치의 값입니다. (해당 구간의 상한, 최대 기록값을 넘지 않음)
+    uint64_t ValueAtPercentile(double percentile) const;
+};
+
+} // namespace streamprotocol
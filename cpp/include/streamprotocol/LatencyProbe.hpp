@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+#include "ParsedPacketView.hpp"
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// PayloadType::PROBE 프레임의 페이로드입니다. (16바이트, LE)
+///   [ 순번 (u64) ][ 송신 측 enqueue 시각 (u64, steady_clock ns) ]
+/// 수신 측은 16바이트보다 긴 페이로드도 받아들이고 뒷부분은 무시합니다.
+struct LatencyProbePayload {
+    static constexpr size_t SIZE = 16;
+
+    uint64_t sequence = 0;
+    uint64_t timestampNs = 0;
+};
+
+/// 송신 경로에 표본 추출한 지연 측정 프레임(PayloadType::PROBE)을 끼워 넣습니다.
+///
+/// 보내는 프레임마다 tick() 을 부르면 sampleEvery 개마다 한 번, 그리고 minInterval 이상 간격으로 true 를 돌려줍니다.
+/// true 일 때 makeProbe()/encodeProbe() 로 만든 프레임을 일반 프레임과 같은 송신 큐에 넣으면,
+/// 수신 측의 LatencyProbeReceiver 가 enqueue 부터 디스패치까지(송신 큐 + 커널 버퍼 + 네트워크 + 수신 디코더)의
+/// 지연을 기록합니다. tick() 은 표본 시점이 아니면 카운터 하나만 줄이므로 비용이 거의 없습니다.
+///
+/// 시각은 steady_clock(리눅스에서 CLOCK_MONOTONIC) 기준이라 같은 호스트의 프로세스 사이에서만 그대로 비교할 수 있습니다.
+/// 다른 호스트와는 LatencyProbeReceiver::Options::clockOffset 으로 시계 차이를 보정해야 합니다.
+/// 인스턴스는 한 스레드에서만 사용해야 합니다.
+class LatencyProbeSender {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        uint32_t sampleEvery = 1024;                                        // 프레임 N 개마다 한 번 (1 이면 매번)
+        std::chrono::nanoseconds minInterval = std::chrono::milliseconds(1);  // 측정 프레임 사이 최소 간격
+        uint16_t userField = 0;                                             // 측정 프레임 헤더의 userField
+    };
+
+private:
+    StreamProtocol& protocol;
+    Options options;
+    uint32_t countdown;
+    uint64_t sequence = 0;
+    Clock::time_point lastProbe = Clock::time_point::min();
+
+    void writePayload(uint8_t* out, Clock::time_point now);
+
+public:
+    LatencyProbeSender(StreamProtocol& protocol, const Options& options);
+    explicit LatencyProbeSender(StreamProtocol& protocol);
+
+    /// 일반 프레임 하나를 보낼 때마다 호출합니다. 지금 측정 프레임을 보내야 하면 true.
+    bool tick();
+
+    /// 측정 프레임을 인코딩합니다. 시각은 now(송신 큐에 넣는 시각)로 찍힙니다.
+    std::vector<uint8_t> makeProbe(Clock::time_point now = Clock::now());
+    /// out 에 측정 프레임을 인코딩하고 크기를 반환합니다. (할당 없음, 용량이 모자라면 PayloadTooLargeException)
+    size_t encodeProbe(uint8_t* out, size_t capacity, Clock::time_point now = Clock::now());
+
+    uint64_t ProbesSent() const { return sequence; }
+
+    /// 측정 프레임 하나의 크기입니다.
+    static constexpr size_t FRAME_SIZE = LatencyProbePayload::SIZE + StreamProtocol::FRAME_OVERHEAD;
+};
+
+/// 수신 측에서 PayloadType::PROBE 프레임을 골라 지연을 LatencyHistogram 에 기록합니다.
+///
+/// 디스패치 경로 맨 앞에서 accept() 를 부르고, true 면 측정 프레임이므로 애플리케이션에 넘기지 않습니다.
+/// 순번으로 유실/순서 뒤바뀜도 셉니다. 인스턴스는 한 스레드에서만 사용해야 하며,
+/// 여러 수신 스레드의 결과는 Latency() 를 LatencyHistogram::merge() 로 합칩니다.
+class LatencyProbeReceiver {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        /// 수신 측 시계 - 송신 측 시계. 다른 호스트의 측정 프레임을 받을 때 지정합니다.
+        std::chrono::nanoseconds clockOffset = std::chrono::nanoseconds::zero();
+    };
+
+    struct Metrics {
+        uint64_t probes = 0;        // 기록한 측정 프레임
+        uint64_t lost = 0;          // 순번이 건너뛴 만큼
+        uint64_t reordered = 0;     // 이전보다 작은 순번
+        uint64_t malformed = 0;     // 페이로드가 16바이트보다 짧은 측정 프레임
+        uint64_t clockSkew = 0;     // 수신 시각이 송신 시각보다 앞선 측정 프레임 (0 으로 기록)
+    };
+
+private:
+    Options options;
+    LatencyHistogram histogram;
+    Metrics stats;
+    uint64_t nextSequence = 0;
+    bool started = false;
+
+public:
+    explicit LatencyProbeReceiver(const Options& options);
+    LatencyProbeReceiver();
+
+    /// frame 이 측정 프레임이면 지연을 기록하고 true 를 반환합니다. 다른 프레임은 건드리지 않고 false.
+    bool accept(const ParsedPacketView& frame, Clock::time_point now = Clock::now());
+    /// 이미 분리한 측정 프레임 페이로드를 기록합니다.
+    void record(const uint8_t* payload, size_t size, Clock::time_point now = Clock::now());
+
+    const LatencyHistogram& Latency() const { return histogram; }
+    const Metrics& GetMetrics() const { return stats; }
+    /// 히스토그램과 통계를 비웁니다. (순번 추적은 유지)
+    void reset();
+
+    /// 측정 프레임 페이로드를 해석합니다. 16바이트보다 짧으면 PacketException.
+    static LatencyProbePayload Decode(const uint8_t* payload, size_t size);
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "ParsedPacket.hpp"
+
+namespace streamprotocol {
+
+/// ParsedPacket 의 비소유(zero-copy) 버전입니다.
+/// 페이로드는 파싱한 원본 버퍼 내부를 가리키므로, 원본 버퍼가 유효한 동안에만 사용해야 합니다.
+class ParsedPacketView {
+private:
+    uint8_t protocolVersion = 0;
+    size_t packetLength = 0;
+    uint8_t fragmentFlag = 0;
+    uint8_t payloadType = 0;
+    uint16_t userField = 0;
+    const uint8_t* payloadData = nullptr;
+    size_t payloadSize = 0;
+
+public:
+    ParsedPacketView() = default;
+    ParsedPacketView(uint8_t ver, size_t len, uint8_t frag, uint8_t type, uint16_t user, const uint8_t* payload, size_t size)
+        : protocolVersion(ver), packetLength(len), fragmentFlag(frag), payloadType(type), userField(user), payloadData(payload), payloadSize(size) {
+    }
+
+    uint8_t ProtocolVersion() const { return protocolVersion; }
+    size_t PacketLength() const { return packetLength; }
+    uint8_t FragmentFlag() const { return fragmentFlag; }
+    uint8_t PayloadType() const { return payloadType; }
+    uint16_t UserField() const { return userField; }
+    const uint8_t* Payload() const { return payloadData; }
+    size_t PayloadSize() const { return payloadSize; }
+
+    /// 페이로드를 복사하여 소유권을 가진 ParsedPacket 으로 변환합니다.
+    ParsedPacket toParsedPacket() const {
+        return ParsedPacket(protocolVersion, packetLength, fragmentFlag, payloadType, userField,
+                            std::vector<uint8_t>(payloadData, payloadData + payloadSize));
+    }
+};
+
+} // namespace streamprotocol
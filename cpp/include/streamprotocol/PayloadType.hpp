@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+namespace streamprotocol {
+
+/// 헤더의 payloadType(4비트) 값 목록입니다.
+/// 0x08~0x0F 는 라이브러리 확장 기능용으로 예약되어 있으므로 애플리케이션은 0x00~0x07 을 사용해야 합니다.
+struct PayloadType {
+    static constexpr uint8_t BINARY = 0x00;            // toBytes(std::vector<uint8_t>)
+    static constexpr uint8_t STRING = 0x01;            // toBytes(std::string)
+
+    static constexpr uint8_t FIRST_RESERVED = 0x08;
+    static constexpr uint8_t SESSION = 0x0A;           // 재개 가능한 세션의 제어 프레임 (SessionSender/Receiver)
+    static constexpr uint8_t DELTA = 0x0B;             // 채널별 XOR 차분 / 키프레임 (DeltaEncoder/Decoder)
+    static constexpr uint8_t PROBE = 0x0C;             // 표본 지연 측정 프레임 (LatencyProbeSender/Receiver)
+    static constexpr uint8_t CONTAINER = 0x0D;         // 작은 레코드 여러 개를 담은 컨테이너 (ContainerReader)
+    static constexpr uint8_t MUX_CONTROL = 0x0E;       // ChannelMux 흐름 제어 프레임
+    static constexpr uint8_t COMPRESSED_LZ = 0x0F;     // 내장 LZ 코덱으로 압축된 페이로드
+
+    static constexpr bool IsReserved(uint8_t type) { return type >= FIRST_RESERVED && type <= 0x0F; }
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace streamprotocol {
+
+/// 여러 연결이 함께 쓰는 수신 메모리 예산입니다. (스레드 안전)
+///
+/// 수신 측은 헤더의 packetLength 만 보고 tryAcquire() 로 바이트를 예약한 뒤에 버퍼를 할당합니다.
+/// 예약은 Lease 가 소멸하거나 release() 될 때 돌아오므로, 프레임을 소비자에게 넘길 때 Lease 도 함께 넘기면
+/// 소비가 끝날 때까지 예산이 유지됩니다.
+class ReceiveBudget {
+public:
+    class Lease {
+    private:
+        ReceiveBudget* budget = nullptr;
+        uint64_t bytes = 0;
+
+        friend class ReceiveBudget;
+        Lease(ReceiveBudget* budget, uint64_t bytes) : budget(budget), bytes(bytes) {}
+
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept : budget(other.budget), bytes(other.bytes) {
+            other.budget = nullptr;
+            other.bytes = 0;
+        }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                budget = other.budget;
+                bytes = other.bytes;
+                other.budget = nullptr;
+                other.bytes = 0;
+            }
+            return *this;
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { release(); }
+
+        void release() {
+            if (budget != nullptr) {
+                budget->inFlight.fetch_sub(bytes, std::memory_order_release);
+                budget = nullptr;
+                bytes = 0;
+            }
+        }
+        uint64_t Bytes() const { return bytes; }
+        explicit operator bool() const { return budget != nullptr; }
+    };
+
+private:
+    std::atomic<uint64_t> inFlight{ 0 };
+    uint64_t capacity;
+
+public:
+    explicit ReceiveBudget(uint64_t capacityBytes) : capacity(capacityBytes) {}
+    ReceiveBudget(const ReceiveBudget&) = delete;
+    ReceiveBudget& operator=(const ReceiveBudget&) = delete;
+
+    /// bytes 를 예약합니다. 예산이 모자라면 빈 Lease(false)를 반환하며 아무것도 예약하지 않습니다.
+    Lease tryAcquire(uint64_t bytes) {
+        uint64_t current = inFlight.load(std::memory_order_relaxed);
+        do {
+            if (bytes > capacity || current > capacity - bytes) {
+                return Lease();
+            }
+        } while (!inFlight.compare_exchange_weak(current, current + bytes, std::memory_order_acquire,
+                                                 std::memory_order_relaxed));
+        return Lease(this, bytes);
+    }
+
+    uint64_t InFlight() const { return inFlight.load(std::memory_order_relaxed); }
+    uint64_t Capacity() const { return capacity; }
+};
+
+} // namespace streamprotocol
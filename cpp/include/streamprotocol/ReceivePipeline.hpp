@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "FrameRing.hpp"
+#include "ParsedPacketView.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// I/O 스레드가 잘라 낸(아직 검증하지 않은) 프레임의 CRC 검증과 페이로드 추출을 여러 코어에 나누는 수신 단계입니다.
+///
+/// - submit() 된 프레임은 워커별 lock-free 작업 큐(슬롯별 시퀀스 번호를 쓰는 링)에 나뉘어 들어가고,
+///   일이 없는 워커는 다른 워커의 큐에서 작업을 훔쳐 옵니다. 훔칠 일도 없으면 자기 조건 변수에서 잠듭니다.
+/// - 프레임마다 잡는 공용 락은 없습니다. 순서 상태는 64개 샤드로 나뉜 락으로 보호하고,
+///   처리 중 프레임 수는 원자 카운터로 셉니다. (maxInFlight 에 걸렸을 때와 drain() 만 락을 씁니다)
+/// - 전달 순서는 스트림(연결) 단위로 submit() 순서와 같습니다. orderByUserField 를 켜면 (스트림, userField) 단위로
+///   순서를 지키므로, 같은 연결의 서로 다른 userField 는 서로 기다리지 않습니다.
+/// - 핸들러는 한 순서 단위 안에서는 한 번에 하나씩, 서로 다른 단위끼리는 여러 워커에서 동시에 호출됩니다.
+///   핸들러는 예외를 던지면 안 됩니다.
+/// - 처리 중인 프레임이 maxInFlight 개에 이르면 submit() 이 블록되어 메모리 사용량이 제한됩니다.
+class ReceivePipeline {
+public:
+    struct Options {
+        size_t workers = 0;                 // 0 이면 std::thread::hardware_concurrency()
+        size_t maxInFlight = 4096;          // 제출되었지만 아직 전달되지 않은 프레임 수 상한 (워커마다 이만큼 큐 슬롯을 잡음)
+        bool orderByUserField = false;      // true 면 (스트림, userField) 단위로 순서 보장
+    };
+
+    /// 검증된 프레임. stream 은 submit() 에 넘긴 값입니다.
+    /// packet 의 페이로드는 frame(submit() 에 넘긴 버퍼 그대로) 안을 가리키며, 페이로드를 앞으로 당기는 복사는 없습니다.
+    /// frame 을 이동해 보관해도 버퍼 주소는 그대로이므로 packet 은 계속 유효합니다.
+    using PacketHandler = std::function<void(uint64_t stream, const ParsedPacketView& packet, std::vector<uint8_t>&& frame)>;
+    /// 검증에 실패한 프레임. error 는 PacketException 계열입니다. 순서상 해당 프레임 자리에서 호출됩니다.
+    using ErrorHandler = std::function<void(uint64_t stream, std::exception_ptr error)>;
+
+    struct WorkerStats {
+        uint64_t processed = 0;
+        uint64_t stolen = 0;        // 다른 워커 큐에서 가져온 작업 수
+    };
+
+private:
+    struct Task {
+        uint64_t stream;
+        uint64_t orderKey;
+        uint64_t sequence;
+        std::vector<uint8_t> frame;
+    };
+
+    struct Result {
+        std::vector<uint8_t> frame;
+        ParsedPacketView packet;                // frame 안을 가리킵니다
+        std::exception_ptr error;
+        bool ready = false;                     // 순서 대기 링에서 이 자리가 찼는지
+    };
+
+    struct OrderState {
+        uint64_t nextSubmit = 0;
+        uint64_t nextDeliver = 0;
+        bool delivering = false;
+        // 순서를 기다리는 결과. sequence & (크기 - 1) 자리에 두는 링으로, 대기 깊이가 크기를 넘을 때만 두 배로 늘리고
+        // 줄이지 않으므로 한 번 자리 잡은 뒤에는 결과마다 할당하지 않습니다. (깊이는 maxInFlight 를 넘지 않음)
+        std::vector<Result> completed;
+    };
+
+    struct OrderShard {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, OrderState> states;
+    };
+
+    /// 여러 생산자(submit)와 여러 소비자(주인 워커, 훔치는 워커)가 함께 쓰는 유한 링입니다.
+    /// 슬롯의 sequence 가 위치와 같으면 빈 슬롯, 위치 + 1 이면 찬 슬롯입니다.
+    /// 용량은 maxInFlight 이상이므로 가득 차는 일은 소비자가 슬롯을 막 비우는 찰나뿐입니다.
+    struct Slot {
+        std::atomic<uint64_t> sequence{ 0 };
+        Task task;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Worker {
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{ 0 };   // 다음 push 위치
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail{ 0 };   // 다음 pop 위치
+        alignas(CACHE_LINE_SIZE) std::unique_ptr<Slot[]> slots;
+        uint64_t mask = 0;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::atomic<bool> sleeping{ false };
+        bool signaled = false;                  // sleepMutex 로 보호
+
+        std::atomic<uint64_t> processed{ 0 };
+        std::atomic<uint64_t> stolen{ 0 };
+
+        explicit Worker(size_t capacity);
+        void push(Task&& task);
+        bool pop(Task& task);
+        bool Empty() const;
+    };
+
+    static constexpr size_t ORDER_SHARDS = 64;
+    static constexpr size_t MIN_ORDER_WINDOW = 16;      // 순서 대기 링의 첫 크기 (2의 거듭제곱)
+
+    const StreamProtocol& protocol;
+    PacketHandler packetHandler;
+    ErrorHandler errorHandler;
+    Options options;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    OrderShard shards[ORDER_SHARDS];
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> inFlight{ 0 };    // 제출 후 전달 전인 프레임 수
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> nextWorker{ 0 };
+    std::atomic<size_t> sleepers{ 0 };
+    std::atomic<size_t> capacityWaiters{ 0 };
+    std::atomic<size_t> drainWaiters{ 0 };
+    std::atomic<bool> stopping{ false };
+
+    // maxInFlight 에 걸린 submit() 과 drain() 만 씁니다.
+    std::mutex waitMutex;
+    std::condition_variable capacityAvailable;
+    std::condition_variable drained;
+
+    uint64_t orderKeyFor(uint64_t stream, const std::vector<uint8_t>& frame) const;
+    OrderShard& shardFor(uint64_t orderKey) { return shards[(orderKey * 0x9E3779B97F4A7C15ull) >> 58]; }
+    void acquireSlot();
+    void releaseSlots(size_t count);
+    bool takeTask(size_t self, Task& task);
+    void wakeWorker(Worker& worker);
+    void wakeIdlePeer(size_t self);
+    void workerLoop(size_t self);
+    Result validate(std::vector<uint8_t>&& frame) const;
+    void complete(const Task& task, Result&& result);
+    static void growWindow(OrderState& state, uint64_t sequence);
+
+public:
+    ReceivePipeline(const StreamProtocol& protocol, PacketHandler onPacket, ErrorHandler onError, const Options& options);
+    ReceivePipeline(const StreamProtocol& protocol, PacketHandler onPacket, ErrorHandler onError);
+    ~ReceivePipeline();
+
+    ReceivePipeline(const ReceivePipeline&) = delete;
+    ReceivePipeline& operator=(const ReceivePipeline&) = delete;
+
+    /// 프레임 하나(헤더 + 페이로드 + CRC)를 제출합니다. 같은 stream 의 submit() 은 한 스레드에서 순서대로 호출해야 합니다.
+    void submit(uint64_t stream, std::vector<uint8_t>&& frame);
+    /// 지금까지 제출한 프레임이 모두 전달될 때까지 기다립니다.
+    void drain();
+    /// 스트림의 순서 상태를 지웁니다. 연결이 끝나고 그 스트림의 프레임이 모두 전달된 뒤에 호출합니다.
+    void closeStream(uint64_t stream);
+
+    size_t Workers() const { return workers.size(); }
+    WorkerStats Stats(size_t worker) const;
+};
+
+} // namespace streamprotocol
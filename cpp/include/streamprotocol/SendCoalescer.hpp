@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace streamprotocol {
+
+/// 인코딩된 프레임을 모아 한 번에 내보내는 송신 측 배치 스케줄러입니다.
+///
+/// 대기 중인 바이트 수(maxBatchBytes), 프레임 수(maxBatchFrames), 가장 오래된 프레임의 마감 시각 중
+/// 먼저 도달하는 조건에서 배치를 싱크로 넘깁니다. 지연은 프레임당 마감 시각으로 제한됩니다.
+///
+/// payloadType 별로 우선순위 단계(0~3)를 지정할 수 있습니다. 높은 단계의 프레임은 배치 안에서
+/// 낮은 단계보다 앞에 놓이고, 단계별 최대 지연(기본: 1 이상은 즉시)을 따로 가집니다.
+///
+/// 마감 시각 처리는 호출자의 이벤트 루프가 NextDeadline() 까지 기다린 뒤 poll() 을 부르는 방식입니다.
+/// 인스턴스는 한 스레드에서만 사용해야 합니다.
+class SendCoalescer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Batch = std::vector<std::vector<uint8_t>>;
+    /// 배치를 받아 실제로 쓰는 함수입니다. 배치 안의 프레임 순서대로 써야 합니다.
+    using Sink = std::function<void(const Batch&)>;
+
+    static constexpr size_t PRIORITY_LEVELS = 4;
+    static constexpr size_t HISTOGRAM_BUCKETS = 8;   // 배치당 프레임 수: 1, 2, 3-4, 5-8, ..., 65+
+
+    struct Options {
+        size_t maxBatchBytes = 64u * 1024u;
+        size_t maxBatchFrames = 64;
+        std::chrono::nanoseconds maxDelay = std::chrono::microseconds(50);
+    };
+
+    enum class FlushReason { Size, Count, Deadline, Priority, Manual };
+
+    struct Metrics {
+        uint64_t batches = 0;
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t flushBySize = 0;
+        uint64_t flushByCount = 0;
+        uint64_t flushByDeadline = 0;
+        uint64_t flushByPriority = 0;   // 즉시 전송 단계의 프레임이 들어와서 내보낸 횟수
+        uint64_t flushManual = 0;
+        std::array<uint64_t, HISTOGRAM_BUCKETS> framesPerBatch{};   // 로그2 버킷 히스토그램
+
+        double AverageFramesPerBatch() const { return batches == 0 ? 0.0 : static_cast<double>(frames) / batches; }
+        double AverageBytesPerBatch() const { return batches == 0 ? 0.0 : static_cast<double>(bytes) / batches; }
+    };
+
+private:
+    struct Pending {
+        std::vector<uint8_t> frame;
+        Clock::time_point enqueued;     // 마감 시각은 enqueued + levelDelay 로 그때그때 계산합니다.
+    };
+
+    Sink sink;
+    Options options;
+    std::array<uint8_t, 16> priorityOf{};
+    std::array<std::chrono::nanoseconds, PRIORITY_LEVELS> levelDelay;
+    std::array<std::deque<Pending>, PRIORITY_LEVELS> queues;
+    size_t pendingBytes = 0;
+    size_t pendingFrames = 0;
+    Batch batch;
+    Metrics stats;
+
+    void flushNow(FlushReason reason);
+
+public:
+    SendCoalescer(Sink sink, const Options& options);
+    explicit SendCoalescer(Sink sink);
+
+    /// payloadType 의 우선순위 단계(0~3)를 지정합니다. 기본값은 모두 0 입니다.
+    void SetPriority(uint8_t payloadType, uint8_t level);
+    /// 우선순위 단계별 최대 지연을 지정합니다. 0 이면 해당 단계 프레임이 들어오는 즉시 내보냅니다.
+    /// 이미 대기 중인 프레임에도 바로 적용되어 NextDeadline() 과 poll() 이 새 지연을 따릅니다.
+    void SetLevelDelay(uint8_t level, std::chrono::nanoseconds maxDelay);
+
+    /// 인코딩된 프레임을 대기시킵니다. payloadType 은 프레임 헤더에서 읽습니다.
+    /// 조건을 만족하면 이 호출 안에서 싱크가 호출되며, 그 경우 true 를 반환합니다.
+    bool enqueue(std::vector<uint8_t>&& frame, Clock::time_point now = Clock::now());
+    bool enqueue(const uint8_t* frame, size_t size, Clock::time_point now = Clock::now());
+
+    /// 마감 시각이 지난 프레임이 있으면 배치를 내보냅니다.
+    bool poll(Clock::time_point now = Clock::now());
+    /// 대기 중인 프레임을 모두 내보냅니다.
+    void flush();
+
+    /// 가장 이른 마감 시각입니다. 대기 중인 프레임이 없으면 Clock::time_point::max().
+    Clock::time_point NextDeadline() const;
+    size_t PendingFrames() const { return pendingFrames; }
+    size_t PendingBytes() const { return pendingBytes; }
+    const Metrics& GetMetrics() const { return stats; }
+
+#if defined(__unix__) || defined(__APPLE__)
+    /// 배치를 writev 로 블로킹 fd 에 쓰는 싱크를 만듭니다. (부분 쓰기/EINTR 처리, 실패 시 std::system_error)
+    static Sink FdSink(int fd);
+#endif
+};
+
+} // namespace streamprotocol
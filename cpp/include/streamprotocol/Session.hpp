@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ParsedPacketView.hpp"
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 인코딩된 프레임을 연속 순번으로 보관하는 재전송 링입니다. 용량(바이트)을 넘으면 가장 오래된 프레임부터 버립니다.
+///
+/// 저장 공간은 메모리이거나, spillDirectory 를 주면 그 디렉터리의 이름 없는 임시 파일을 mmap 한 영역입니다. (POSIX)
+/// 파일 영역은 커널이 필요할 때 디스크로 내보내므로 큰 창을 잡아도 상주 메모리가 늘지 않습니다.
+/// 순번 색인은 메모리에만 있으므로 프로세스 재시작 후에는 이어 쓸 수 없습니다.
+/// 인스턴스는 한 스레드에서만 사용해야 합니다.
+class RetransmitRing {
+public:
+    struct Options {
+        size_t capacity = 64u * 1024u * 1024u;
+        std::string spillDirectory;         // 비어 있으면 메모리
+    };
+
+private:
+    struct Entry {
+        size_t offset;
+        size_t size;
+    };
+
+    std::unique_ptr<uint8_t[]> memory;
+    uint8_t* storage = nullptr;     // memory 또는 spill 파일 매핑
+    size_t capacity = 0;
+    int fd = -1;
+    std::deque<Entry> entries;      // entries[i] 는 순번 oldest + i
+    uint64_t oldest = 0;
+    size_t tail = 0;
+    size_t usedBytes = 0;
+    uint64_t droppedFrames = 0;
+
+    bool place(size_t size, size_t& offset) const;
+    void popOldest();
+
+public:
+    explicit RetransmitRing(const Options& options);
+    RetransmitRing();
+    ~RetransmitRing();
+
+    RetransmitRing(const RetransmitRing&) = delete;
+    RetransmitRing& operator=(const RetransmitRing&) = delete;
+
+    /// 다음 순번으로 프레임을 보관하고 그 순번을 반환합니다. 용량보다 큰 프레임은 보관하지 않고 순번만 씁니다.
+    uint64_t push(const uint8_t* frame, size_t size);
+    /// sequence 보다 작은 순번의 프레임을 버립니다. (상대가 받았다고 확인한 만큼)
+    void release(uint64_t sequence);
+    /// 모든 프레임을 버리고 순번을 0 부터 다시 셉니다.
+    void reset();
+    /// from 부터 마지막까지 보관 중인 프레임을 순서대로 넘깁니다. from 이 OldestSequence() 보다 작으면 false.
+    bool forEachFrom(uint64_t from, const std::function<void(const uint8_t* frame, size_t size)>& visit) const;
+
+    /// 보관 중인 가장 오래된 순번입니다. (비어 있으면 NextSequence())
+    uint64_t OldestSequence() const { return oldest; }
+    uint64_t NextSequence() const { return oldest + entries.size(); }
+    size_t Frames() const { return entries.size(); }
+    size_t Bytes() const { return usedBytes; }
+    size_t Capacity() const { return capacity; }
+    /// 확인되기 전에 용량 때문에 버린 프레임 수입니다.
+    uint64_t DroppedFrames() const { return droppedFrames; }
+};
+
+/// 세션 제어 프레임(PayloadType::SESSION)입니다. 페이로드는 17바이트 LE: [ 종류 (u8) ][ 세션 ID (u64) ][ 순번 (u64) ]
+///   HELLO  : 송신 측이 연결(재연결) 직후 보냅니다. 순번 = 다음에 보낼 프레임 순번
+///   RESUME : 수신 측이 HELLO 에 답합니다. 순번 = 지금까지 받은 데이터 프레임 수 (여기서부터 다시 보내면 됨)
+///   ACK    : 수신 측이 주기적으로 보냅니다. 순번 = 지금까지 받은 데이터 프레임 수
+struct SessionControl {
+    enum Kind : uint8_t { HELLO = 1, RESUME = 2, ACK = 3 };
+    static constexpr size_t SIZE = 17;
+
+    uint8_t kind = 0;
+    uint64_t sessionId = 0;
+    uint64_t sequence = 0;
+
+    /// 제어 프레임 페이로드를 해석합니다. 잘못된 페이로드는 PacketException.
+    static SessionControl Decode(const uint8_t* payload, size_t size);
+};
+
+/// 재연결해도 이어서 보낼 수 있는 세션의 송신 측입니다.
+///
+/// 데이터 프레임에는 따로 순번을 싣지 않습니다. 세션 시작부터 보낸 데이터 프레임의 개수가 곧 순번이며,
+/// 순서를 보장하는 전송(TCP 등)에서 양쪽이 같은 수를 셉니다. 보낸 프레임은 RetransmitRing 에 보관했다가
+/// 수신 측 ACK 로 확인된 만큼 버립니다.
+///
+/// 사용 순서:
+///   1. 연결(재연결)할 때마다 hello() 로 만든 프레임을 가장 먼저 씁니다. 이때부터 Resuming() 이 true 입니다.
+///   2. 보낼 프레임은 언제나 record() 에 넘기고, Resuming() 이 false 일 때만 직접 씁니다.
+///   3. 수신한 프레임은 accept() 에 넘깁니다. RESUME 이 오면 상대가 받지 못한 프레임을 write 로 다시 보내고
+///      Resumed 를 돌려줍니다. 상대가 원하는 순번이 이미 링에서 밀려났으면 Lost 이며, 새 세션(newSession())으로 처음부터 보내야 합니다.
+/// 인스턴스는 한 스레드에서만 사용해야 합니다.
+class SessionSender {
+public:
+    using Write = std::function<void(const uint8_t* frame, size_t size)>;
+
+    enum class Event { None, Acked, Resumed, Lost };
+
+    struct Options {
+        size_t retransmitBytes = 64u * 1024u * 1024u;  // 확인되지 않은 프레임 보관 한도
+        std::string spillDirectory;                    // 비어 있지 않으면 재전송 링을 이 디렉터리의 mmap 파일에 둠
+        uint64_t sessionId = 0;                        // 0 이면 무작위
+    };
+
+    struct Metrics {
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t resumes = 0;
+        uint64_t resentFrames = 0;
+        uint64_t resentBytes = 0;
+        uint64_t lost = 0;          // 링에 없는 순번을 요구받아 이어 보내지 못한 횟수
+    };
+
+private:
+    StreamProtocol& protocol;
+    RetransmitRing ring;
+    uint64_t sessionId;
+    bool resuming = false;
+    Metrics stats;
+
+public:
+    SessionSender(StreamProtocol& protocol, const Options& options);
+    explicit SessionSender(StreamProtocol& protocol);
+
+    /// 연결 직후 가장 먼저 보낼 HELLO 프레임입니다. RESUME 을 받을 때까지 Resuming() 이 true 가 됩니다.
+    std::vector<uint8_t> hello();
+    /// 인코딩된 데이터 프레임을 보관하고 순번을 반환합니다. Resuming() 이 false 면 호출자가 이어서 직접 씁니다.
+    uint64_t record(const uint8_t* frame, size_t size);
+    /// SESSION 프레임이면 처리하고 결과를 반환합니다. 다른 프레임은 None.
+    Event accept(const ParsedPacketView& frame, const Write& write);
+    /// 세션 ID 를 바꾸고 보관한 프레임을 버립니다. 순번은 0 부터 다시 셉니다.
+    void newSession(uint64_t sessionId = 0);
+
+    bool Resuming() const { return resuming; }
+    uint64_t SessionId() const { return sessionId; }
+    uint64_t NextSequence() const { return ring.NextSequence(); }
+    /// 상대가 확인한 순번입니다. (이보다 작은 프레임은 버렸음)
+    uint64_t AckedSequence() const { return ring.OldestSequence(); }
+    size_t UnackedBytes() const { return ring.Bytes(); }
+    const RetransmitRing& Ring() const { return ring; }
+    const Metrics& GetMetrics() const { return stats; }
+};
+
+/// 세션의 수신 측입니다. 받은 데이터 프레임 수를 세고, HELLO 에는 RESUME 으로, ackEvery 프레임마다 ACK 로 답합니다.
+///
+/// accept() 가 true 면 애플리케이션에 넘길 데이터 프레임, false 면 처리가 끝난 제어 프레임입니다.
+/// 어느 경우든 reply 가 비어 있지 않으면 그대로 상대에게 써야 합니다.
+/// 수신 측 객체는 연결이 끊겨도 유지해야 이어 받을 수 있습니다. 인스턴스는 한 스레드에서만 사용해야 합니다.
+class SessionReceiver {
+public:
+    struct Options {
+        uint32_t ackEvery = 256;        // 데이터 프레임 N 개마다 ACK
+    };
+
+private:
+    StreamProtocol& protocol;
+    Options options;
+    uint64_t sessionId = 0;
+    uint64_t received = 0;
+    uint32_t sinceAck = 0;
+    bool active = false;
+
+    std::vector<uint8_t> control(uint8_t kind);
+
+public:
+    SessionReceiver(StreamProtocol& protocol, const Options& options);
+    explicit SessionReceiver(StreamProtocol& protocol);
+
+    bool accept(const ParsedPacketView& frame, std::vector<uint8_t>& reply);
+    /// 지금까지 받은 수를 담은 ACK 프레임입니다. (유휴 구간에서 송신 측 링을 비우게 할 때)
+    std::vector<uint8_t> ack();
+
+    bool Active() const { return active; }
+    uint64_t SessionId() const { return sessionId; }
+    uint64_t Received() const { return received; }
+};
+
+} // namespace streamprotocol
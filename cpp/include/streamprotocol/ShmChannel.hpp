@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "FrameRing.hpp"
+
+namespace streamprotocol {
+
+struct ShmRegionHeader;
+
+/// 같은 호스트의 프로세스 간에 StreamProtocol 프레임을 주고받는 단방향 공유 메모리 채널입니다. (Linux 전용)
+///
+/// memfd_create 또는 shm_open 으로 만든 영역 안에 SpscFrameRing 을 두고,
+/// 쓰는 쪽은 링 안에서 바로 인코딩하고 읽는 쪽은 링 안에서 헤더/CRC 를 검증합니다.
+/// 상대편이 유휴 상태일 때만 futex 로 깨우므로, 바쁜 구간에서는 시스템 콜이 발생하지 않습니다.
+///
+/// 한 채널에는 쓰는 프로세스 하나와 읽는 프로세스 하나만 붙어야 합니다. 양방향 통신은 채널 두 개를 사용합니다.
+class ShmFrameChannel {
+private:
+    int fd = -1;
+    uint8_t* mapping = nullptr;
+    size_t mappingSize = 0;
+    ShmRegionHeader* header = nullptr;
+    std::unique_ptr<SpscFrameRing> ring;
+
+    ShmFrameChannel(int fd, bool initialize, size_t capacity, const StreamProtocol& protocol);
+
+    void wakeReader();
+    void wakeWriter();
+    bool tryRead(ParsedPacketView& view);
+
+public:
+    /// 이름 있는 공유 메모리(/dev/shm)를 새로 만듭니다. 이미 있으면 std::system_error.
+    static ShmFrameChannel create(const std::string& name, size_t capacity, const StreamProtocol& protocol = StreamProtocol());
+    /// 이름 없는 memfd 영역을 만듭니다. Fd() 를 fork 나 SCM_RIGHTS 로 상대 프로세스에 넘겨 fromFd() 로 엽니다.
+    static ShmFrameChannel createAnonymous(size_t capacity, const StreamProtocol& protocol = StreamProtocol());
+    /// create() 로 만든 채널을 엽니다.
+    static ShmFrameChannel open(const std::string& name, const StreamProtocol& protocol = StreamProtocol());
+    /// 넘겨받은 fd 로 채널을 엽니다. fd 의 소유권을 가져갑니다.
+    static ShmFrameChannel fromFd(int fd, const StreamProtocol& protocol = StreamProtocol());
+    /// 이름 있는 공유 메모리를 삭제합니다. 이미 매핑한 프로세스는 계속 사용할 수 있습니다.
+    static void unlink(const std::string& name);
+
+    ShmFrameChannel(ShmFrameChannel&& other) noexcept;
+    ShmFrameChannel& operator=(ShmFrameChannel&& other) noexcept;
+    ShmFrameChannel(const ShmFrameChannel&) = delete;
+    ShmFrameChannel& operator=(const ShmFrameChannel&) = delete;
+    ~ShmFrameChannel();
+
+    int Fd() const { return fd; }
+    size_t Capacity() const { return ring->Capacity(); }
+    size_t MaxPayloadSize() const { return ring->MaxPayloadSize(); }
+
+    // ---- 쓰는 쪽 ----
+    // timeoutMs: 음수 = 무한 대기, 0 = 대기하지 않음
+
+    /// 공간이 생길 때까지 기다려 슬롯을 예약합니다. 시간 초과 시 빈 슬롯을 반환합니다.
+    FrameSlot reserve(size_t payloadSize, int timeoutMs = -1);
+    /// 헤더/CRC 를 제자리에 기록하고 공개합니다. 읽는 쪽이 잠들어 있으면 깨웁니다.
+    void commit(FrameSlot& slot, uint8_t payloadType, uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00);
+    /// 이미 완성된 프레임을 공개합니다.
+    void commitFrame(FrameSlot& slot);
+    /// 예약을 포기합니다. 읽는 쪽이 이 레코드를 건너뛰어 공간을 돌려주도록 깨웁니다.
+    /// (commit() 이 헤더 기록에 실패해 예외를 던질 때도 같은 방식으로 취소됩니다.)
+    void cancel(FrameSlot& slot);
+    bool write(const uint8_t* payload, size_t size, uint8_t payloadType,
+               uint8_t fragFlag = StreamProtocol::UNFRAGED, uint16_t userValue = 0x00, int timeoutMs = -1);
+
+    // ---- 읽는 쪽 ----
+
+    /// 다음 프레임을 공유 메모리 안에서 검증하여 뷰로 돌려줍니다. 시간 초과 시 false.
+    /// 검증에 실패하면 PacketException 을 던지며, release() 로 해당 프레임을 건너뛸 수 있습니다.
+    bool read(ParsedPacketView& view, int timeoutMs = -1);
+    /// 마지막으로 읽은 프레임을 해제합니다. 쓰는 쪽이 공간을 기다리고 있으면 깨웁니다.
+    void release();
+};
+
+} // namespace streamprotocol
@@ -5,35 +5,71 @@
 #include <string>
 #include <limits>
 
+#include "FrameHeader.hpp"
 #include "PacketException.h"
 #include "ParsedPacket.hpp"
+#include "ParsedPacketView.hpp"
 
 namespace streamprotocol {
 
+class FrameBuffer;
+
 class StreamProtocol {
 private:
-    static constexpr size_t HEADER_SIZE = 8;               // 8 bytes
     static constexpr uint64_t MAX_HEADER_LENGTH_VALUE = 0x1FFFFFFFFFFFL; // 45-bit max
 
-    uint8_t protocolVersion = 1; // Default protocol version (4-bit, 0-15)
+    uint8_t protocolVersion = DEFAULT_PROTOCOL_VERSION; // Default protocol version (4-bit, 0-15)
 
-    uint32_t computeCRC32(const uint8_t* data, size_t length);
-    std::vector<uint8_t> buildPacket(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue);
+    uint32_t computeCRC32(const uint8_t* data, size_t length, uint8_t version) const;
+    std::vector<uint8_t> buildPacket(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const;
+    // Validates buffer size and header; the returned view's CRC has not been checked yet.
+    ParsedPacketView checkFrame(const uint8_t* packet, size_t size) const;
 
 public:
+    static constexpr size_t HEADER_SIZE = 8;               // 8 bytes
     static constexpr uint8_t FRAGED = 0x01;
     static constexpr uint8_t UNFRAGED = 0x00;
 
+    // Frames whose protocolVersion is CRC32C_PROTOCOL_VERSION carry a CRC32C trailer instead of CRC32.
+    // Every other version (including the default, 1) keeps CRC32, so version-1 peers interoperate unchanged.
+    static constexpr uint8_t DEFAULT_PROTOCOL_VERSION = 1;
+    static constexpr uint8_t CRC32C_PROTOCOL_VERSION = 2;
+
     static constexpr size_t MAX_PACKET_LENGTH = static_cast<size_t>(
         (MAX_HEADER_LENGTH_VALUE < static_cast<uint64_t>(std::numeric_limits<size_t>::max()))
             ? MAX_HEADER_LENGTH_VALUE
             : static_cast<uint64_t>(std::numeric_limits<size_t>::max()));
     static constexpr size_t MAX_PAYLOAD_LENGTH = MAX_PACKET_LENGTH - HEADER_SIZE - sizeof(uint32_t);
+    static constexpr size_t FRAME_OVERHEAD = HEADER_SIZE + sizeof(uint32_t); // header + CRC
+
+    std::vector<uint8_t> toBytes(const std::string& payload, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
+    std::vector<uint8_t> toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue, size_t bufferSize) const;
+    std::vector<uint8_t> toBytes(const std::vector<uint8_t>& payload, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
+    // Reuses the payload's storage: the payload is shifted by 8 bytes in place and the frame is
+    // returned in the same allocation (no new allocation when capacity >= size + FRAME_OVERHEAD).
+    std::vector<uint8_t> toBytes(std::vector<uint8_t>&& payload, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
+    std::vector<uint8_t> toBytes(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
+    // Stamps header and CRC into the buffer's reserved headroom/tailroom and hands over its storage.
+    std::vector<uint8_t> toBytes(FrameBuffer&& buffer, uint8_t payloadType = 0x00, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
+
+    // Writes only the 8-byte header for a frame that will carry payloadSize bytes.
+    void encodeHeader(uint8_t* header, size_t payloadSize, uint8_t payloadType, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
+
+    // Encodes a whole frame into out[0 .. capacity), copying the payload and computing the CRC in a
+    // single pass. Returns the frame length; throws PayloadTooLargeException when capacity is short.
+    size_t encodeInto(const uint8_t* data, size_t size, uint8_t* out, size_t capacity, uint8_t payloadType,
+                      uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
 
-    std::vector<uint8_t> toBytes(const std::string& payload, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00);
-    std::vector<uint8_t> toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue, size_t bufferSize);
+    // In-place encoding: frame[8 .. 8+payloadSize) must already hold the payload.
+    // Writes the header in front of it and the CRC behind it, returns the frame length.
+    size_t sealFrame(uint8_t* frame, size_t payloadSize, uint8_t payloadType, uint8_t fragFlag = UNFRAGED, uint16_t userValue = 0x00) const;
 
     ParsedPacket parsePacket(const std::vector<uint8_t>& packetBytes);
+    // Decodes and validates only the 8-byte header (length range); payload and CRC are not checked.
+    FrameHeader decodeHeader(const uint8_t* header) const;
+    // Zero-copy parse: the returned view points into packet.
+    ParsedPacketView parsePacketView(const uint8_t* packet, size_t size) const;
+    uint8_t ProtocolVersion() const;
     void SetProtocolVersion(uint8_t version);
 };
 
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "FrameBuffer.hpp"
+#include "PacketException.h"
+#include "ParsedPacketView.hpp"
+#include "PayloadType.hpp"
+#include "StreamProtocol.hpp"
+
+namespace streamprotocol {
+
+/// 고정 크기 필드입니다. T 는 정수, enum, float, double 중 하나이며 리틀 엔디언으로 sizeof(T) 정렬 위치에 놓입니다.
+template <typename T>
+struct Field {
+    static_assert((std::is_integral<T>::value && !std::is_same<T, bool>::value) || std::is_enum<T>::value ||
+                      std::is_floating_point<T>::value,
+                  "Field<T> needs an integer, enum or floating point type");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "unsupported field size");
+
+    using Type = T;
+    static constexpr bool VARIABLE = false;
+    static constexpr size_t SIZE = sizeof(T);
+    static constexpr size_t ALIGN = sizeof(T);
+};
+
+/// 가변 길이 바이트 필드입니다. 고정 영역에는 (오프셋 u32, 길이 u32) 자리만 두고, 데이터는 고정 영역 뒤에 붙습니다.
+struct Bytes {
+    static constexpr bool VARIABLE = true;
+    static constexpr size_t SIZE = 8;
+    static constexpr size_t ALIGN = 4;
+};
+
+namespace detail {
+
+template <size_t Size> struct UnsignedOf;
+template <> struct UnsignedOf<1> { using Type = uint8_t; };
+template <> struct UnsignedOf<2> { using Type = uint16_t; };
+template <> struct UnsignedOf<4> { using Type = uint32_t; };
+template <> struct UnsignedOf<8> { using Type = uint64_t; };
+
+// 리틀 엔디언 대상(GCC/Clang 매크로, MSVC 는 항상 LE)에서는 memcpy 한 번, 그 밖에는 바이트 단위로 조립합니다.
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_MSC_VER)
+#define STREAMPROTOCOL_MESSAGE_NATIVE_LE 1
+#endif
+
+template <typename T>
+inline T loadLE(const uint8_t* in) {
+    T value;
+#if defined(STREAMPROTOCOL_MESSAGE_NATIVE_LE)
+    std::memcpy(&value, in, sizeof(T));
+#else
+    using U = typename UnsignedOf<sizeof(T)>::Type;
+    U bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bits = static_cast<U>(bits | static_cast<U>(static_cast<U>(in[i]) << (i * 8)));
+    }
+    std::memcpy(&value, &bits, sizeof(T));
+#endif
+    return value;
+}
+
+template <typename T>
+inline void storeLE(uint8_t* out, T value) {
+#if defined(STREAMPROTOCOL_MESSAGE_NATIVE_LE)
+    std::memcpy(out, &value, sizeof(T));
+#else
+    using U = typename UnsignedOf<sizeof(T)>::Type;
+    U bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+#endif
+}
+
+} // namespace detail
+
+/// 고정 레이아웃 메시지 정의입니다. 필드는 선언 순서대로 각자의 정렬에 맞춰 놓이고, 고정 영역은 8바이트 배수입니다.
+///
+///   struct Quote : streamprotocol::Message<0x02, Field<uint64_t>, Field<int64_t>, Field<uint32_t>, Bytes> {
+///       enum : size_t { Timestamp, Price, Quantity, Symbol };
+///   };
+///
+/// 필드를 바꾸면 와이어 형식이 바뀌므로, 호환이 필요하면 끝에만 추가하고 PAYLOAD_TYPE 을 나눠 쓰십시오.
+/// (뒤에 추가된 필드는 예전 송신자의 짧은 페이로드를 MessageView 가 거부하는 방식으로 드러납니다)
+template <uint8_t Type, typename... Fields>
+struct Message {
+    static_assert(Type <= 0x0F && !PayloadType::IsReserved(Type), "message payloadType must be 0x00-0x07");
+    static_assert(sizeof...(Fields) > 0, "message needs at least one field");
+
+    static constexpr uint8_t PAYLOAD_TYPE = Type;
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    template <size_t I>
+    using FieldAt = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+private:
+    static constexpr std::array<size_t, FIELD_COUNT + 1> layout() {
+        constexpr size_t sizes[] = { Fields::SIZE... };
+        constexpr size_t aligns[] = { Fields::ALIGN... };
+        std::array<size_t, FIELD_COUNT + 1> offsets{};
+        size_t offset = 0;
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            offset = (offset + aligns[i] - 1) / aligns[i] * aligns[i];
+            offsets[i] = offset;
+            offset += sizes[i];
+        }
+        offsets[FIELD_COUNT] = (offset + 7) / 8 * 8;
+        return offsets;
+    }
+
+    static constexpr std::array<size_t, FIELD_COUNT + 1> LAYOUT = layout();
+
+public:
+    /// 고정 영역 크기입니다. 가변 필드 데이터는 이 뒤에 붙습니다.
+    static constexpr size_t FIXED_SIZE = LAYOUT[FIELD_COUNT];
+
+    template <size_t I>
+    static constexpr size_t OffsetOf() {
+        static_assert(I < FIELD_COUNT, "field index out of range");
+        return LAYOUT[I];
+    }
+};
+
+/// 수신 버퍼 위에서 필드를 바로 읽는 메시지 뷰입니다. (복사/할당 없음)
+///
+/// 생성 시 payloadType, 고정 영역 크기, 가변 필드의 범위를 한 번 검증하며 잘못된 페이로드는 PacketException 입니다.
+/// 그 뒤의 필드 접근은 검사 없이 오프셋에서 바로 읽습니다. 원본 버퍼가 유효한 동안에만 사용해야 합니다.
+template <typename M>
+class MessageView {
+private:
+    const uint8_t* payload = nullptr;
+    size_t size = 0;
+
+    template <size_t I>
+    void checkVariable() const {
+        if constexpr (M::template FieldAt<I>::VARIABLE) {
+            uint32_t offset = detail::loadLE<uint32_t>(payload + M::template OffsetOf<I>());
+            uint32_t length = detail::loadLE<uint32_t>(payload + M::template OffsetOf<I>() + 4);
+            // 설정하지 않은 가변 필드는 (0, 0) 으로 남아 빈 값으로 읽힙니다.
+            if ((length != 0 && offset < M::FIXED_SIZE) || offset > size || length > size - offset) {
+                throw PacketException("Message field " + std::to_string(I) + " exceeds payload: offset " +
+                                      std::to_string(offset) + ", length " + std::to_string(length) + " (payload " +
+                                      std::to_string(size) + " bytes)");
+            }
+        }
+    }
+
+    template <size_t... I>
+    void checkAll(std::index_sequence<I...>) const {
+        (checkVariable<I>(), ...);
+    }
+
+public:
+    MessageView(const uint8_t* payload, size_t size) : payload(payload), size(size) {
+        if (payload == nullptr || size < M::FIXED_SIZE) {
+            throw PacketException("Message payload too short: " + std::to_string(size) + " bytes (min: " +
+                                  std::to_string(M::FIXED_SIZE) + ")");
+        }
+        checkAll(std::make_index_sequence<M::FIELD_COUNT>());
+    }
+
+    /// frame 의 payloadType 이 M::PAYLOAD_TYPE 이 아니면 std::invalid_argument.
+    explicit MessageView(const ParsedPacketView& frame) : MessageView(checkType(frame), frame.PayloadSize()) {
+    }
+
+    template <size_t I>
+    typename M::template FieldAt<I>::Type get() const {
+        using F = typename M::template FieldAt<I>;
+        static_assert(!F::VARIABLE, "use bytes<I>() for variable-length fields");
+        return detail::loadLE<typename F::Type>(payload + M::template OffsetOf<I>());
+    }
+
+    template <size_t I>
+    const uint8_t* bytes() const {
+        static_assert(M::template FieldAt<I>::VARIABLE, "bytes<I>() needs a Bytes field");
+        return payload + detail::loadLE<uint32_t>(payload + M::template OffsetOf<I>());
+    }
+
+    template <size_t I>
+    size_t sizeOf() const {
+        static_assert(M::template FieldAt<I>::VARIABLE, "sizeOf<I>() needs a Bytes field");
+        return detail::loadLE<uint32_t>(payload + M::template OffsetOf<I>() + 4);
+    }
+
+    template <size_t I>
+    std::string_view string() const {
+        return std::string_view(reinterpret_cast<const char*>(bytes<I>()), sizeOf<I>());
+    }
+
+    const uint8_t* Payload() const { return payload; }
+    size_t PayloadSize() const { return size; }
+
+private:
+    static const uint8_t* checkType(const ParsedPacketView& frame) {
+        if (frame.PayloadType() != M::PAYLOAD_TYPE) {
+            throw std::invalid_argument("frame payloadType " + std::to_string(frame.PayloadType()) +
+                                        " does not match message type " + std::to_string(M::PAYLOAD_TYPE));
+        }
+        return frame.Payload();
+    }
+};
+
+/// 인코딩 버퍼(FrameBuffer)에 필드를 바로 쓰는 메시지 빌더입니다.
+///
+/// 고정 영역은 0 으로 시작하고, 가변 필드는 setBytes() 순서대로 고정 영역 뒤에 붙습니다. (필드마다 한 번, 생략하면 빈 값)
+/// encode() 는 버퍼를 그대로 프레임으로 넘기므로 페이로드 복사가 없습니다.
+template <typename M>
+class MessageBuilder {
+private:
+    FrameBuffer buffer;
+    size_t variableCapacity;
+
+    /// 고정 영역을 0 으로 채워 빈 메시지로 시작합니다. (재사용한 버퍼의 이전 내용이 남지 않게)
+    void startMessage() {
+        buffer.reserve(M::FIXED_SIZE + variableCapacity);
+        buffer.resize(M::FIXED_SIZE);
+        std::memset(buffer.Payload(), 0, M::FIXED_SIZE);
+    }
+
+public:
+    /// variableCapacity 는 가변 필드 데이터용으로 미리 잡아 둘 바이트 수입니다. encode() 뒤에도 유지됩니다.
+    explicit MessageBuilder(size_t variableCapacity = 0) : variableCapacity(variableCapacity) {
+        startMessage();
+    }
+
+    /// 전송이 끝난 프레임 벡터의 용량을 재사용합니다.
+    explicit MessageBuilder(std::vector<uint8_t>&& reuse, size_t variableCapacity = 0)
+        : buffer(std::move(reuse)), variableCapacity(variableCapacity) {
+        startMessage();
+    }
+
+    template <size_t I>
+    MessageBuilder& set(typename M::template FieldAt<I>::Type value) {
+        using F = typename M::template FieldAt<I>;
+        static_assert(!F::VARIABLE, "use setBytes<I>() for variable-length fields");
+        detail::storeLE<typename F::Type>(buffer.Payload() + M::template OffsetOf<I>(), value);
+        return *this;
+    }
+
+    template <size_t I>
+    MessageBuilder& setBytes(const uint8_t* data, size_t size) {
+        static_assert(M::template FieldAt<I>::VARIABLE, "setBytes<I>() needs a Bytes field");
+        size_t offset = buffer.PayloadSize();
+        if (offset > UINT32_MAX || size > UINT32_MAX - offset) {
+            throw std::invalid_argument("variable-length fields must end within 4 GiB of the payload start");
+        }
+        buffer.append(data, size);
+        uint8_t* slot = buffer.Payload() + M::template OffsetOf<I>();
+        detail::storeLE<uint32_t>(slot, static_cast<uint32_t>(offset));
+        detail::storeLE<uint32_t>(slot + 4, static_cast<uint32_t>(size));
+        return *this;
+    }
+
+    template <size_t I>
+    MessageBuilder& setString(std::string_view text) {
+        return setBytes<I>(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    }
+
+    /// 가변 필드용 공간을 size 바이트 붙이고 그 위치를 돌려줍니다. 호출자가 직접 채웁니다. (다음 setBytes/reserveBytes 전까지 유효)
+    template <size_t I>
+    uint8_t* reserveBytes(size_t size) {
+        size_t offset = buffer.PayloadSize();
+        setBytes<I>(nullptr, 0);
+        if (size > UINT32_MAX - offset) {
+            throw std::invalid_argument("variable-length fields must end within 4 GiB of the payload start");
+        }
+        buffer.resize(offset + size);
+        detail::storeLE<uint32_t>(buffer.Payload() + M::template OffsetOf<I>() + 4, static_cast<uint32_t>(size));
+        return buffer.Payload() + offset;
+    }
+
+    const uint8_t* Payload() const { return buffer.Payload(); }
+    size_t PayloadSize() const { return buffer.PayloadSize(); }
+
+    /// 프레임을 봉인해 반환합니다. 빌더는 빈 고정 영역으로 다시 시작합니다.
+    std::vector<uint8_t> encode(const StreamProtocol& protocol, uint16_t userField = 0) {
+        std::vector<uint8_t> frame =
+            protocol.toBytes(std::move(buffer), M::PAYLOAD_TYPE, StreamProtocol::UNFRAGED, userField);
+        startMessage();
+        return frame;
+    }
+};
+
+/// payloadType 으로 메시지 핸들러를 고르는 디스패처입니다. 인스턴스는 한 스레드에서만 사용해야 합니다.
+class MessageDispatcher {
+private:
+    std::array<std::function<void(const ParsedPacketView&)>, 16> handlers;
+
+public:
+    /// M::PAYLOAD_TYPE 프레임을 MessageView<M> 으로 넘기는 핸들러를 등록합니다. (같은 타입은 덮어씀)
+    template <typename M, typename Handler>
+    void on(Handler handler) {
+        handlers[M::PAYLOAD_TYPE] = [handler](const ParsedPacketView& frame) {
+            handler(MessageView<M>(frame.Payload(), frame.PayloadSize()), frame);
+        };
+    }
+
+    /// 등록된 타입이면 핸들러를 호출하고 true. 페이로드가 레이아웃에 맞지 않으면 PacketException.
+    bool dispatch(const ParsedPacketView& frame) const {
+        const auto& handler = handlers[frame.PayloadType() & 0x0F];
+        if (!handler) {
+            return false;
+        }
+        handler(frame);
+        return true;
+    }
+};
+
+} // namespace streamprotocol
@@ -0,0 +1,221 @@
+#include "streamprotocol/BoundedDecoder.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "Detail.hpp"
+
+namespace streamprotocol {
+
+namespace {
+
+#if defined(__unix__) || defined(__APPLE__)
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+#endif
+
+} // namespace
+
+BoundedDecoder::SpilledFrame::SpilledFrame(SpilledFrame&& other) noexcept
+    : fd(other.fd), header(other.header), size(other.size) {
+    other.fd = -1;
+}
+
+BoundedDecoder::SpilledFrame& BoundedDecoder::SpilledFrame::operator=(SpilledFrame&& other) noexcept {
+    if (this != &other) {
+#if defined(__unix__) || defined(__APPLE__)
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+        fd = other.fd;
+        header = other.header;
+        size = other.size;
+        other.fd = -1;
+    }
+    return *this;
+}
+
+BoundedDecoder::SpilledFrame::~SpilledFrame() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+}
+
+void BoundedDecoder::SpilledFrame::read(uint64_t offset, uint8_t* out, size_t length) const {
+    if (offset > size || length > size - offset) {
+        throw std::out_of_range("read beyond spilled payload");
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    while (length > 0) {
+        ssize_t got = ::pread(fd, out, length, static_cast<off_t>(offset));
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("pread");
+        }
+        if (got == 0) {
+            throw std::system_error(EIO, std::generic_category(), "spill file truncated");
+        }
+        out += got;
+        offset += static_cast<uint64_t>(got);
+        length -= static_cast<size_t>(got);
+    }
+#else
+    (void)out;
+    throw std::logic_error("spill is not supported on this platform");
+#endif
+}
+
+BoundedDecoder::BoundedDecoder(const StreamProtocol& protocol, ReceiveBudget* budget, Callbacks callbacks)
+    : BoundedDecoder(protocol, budget, std::move(callbacks), Options()) {
+}
+
+BoundedDecoder::BoundedDecoder(const StreamProtocol& protocol, ReceiveBudget* budget, Callbacks callbacks,
+                               const Options& options)
+    : callbacks(std::move(callbacks)), options(options), budget(budget),
+      reader(protocol, FrameReader::Callbacks{
+                           [this](const FrameHeader& header) { onHeader(header); },
+                           [this](const FrameHeader&, const uint8_t* data, size_t size) { onPayload(data, size); },
+                           [this](const FrameHeader& header, bool crcValid) { onEnd(header, crcValid); } }) {
+    if (!this->callbacks.onFrame) {
+        throw std::invalid_argument("BoundedDecoder requires an onFrame callback");
+    }
+    if (options.maxFrameSize < StreamProtocol::FRAME_OVERHEAD) {
+        throw std::invalid_argument("maxFrameSize must be at least 12");
+    }
+    if (options.overflow == Overflow::Spill) {
+#if defined(__unix__) || defined(__APPLE__)
+        if (!this->callbacks.onSpilled) {
+            throw std::invalid_argument("Spill overflow requires an onSpilled callback");
+        }
+#else
+        throw std::invalid_argument("Spill overflow is not supported on this platform");
+#endif
+    }
+}
+
+BoundedDecoder::~BoundedDecoder() {
+    closeSpill();
+}
+
+void BoundedDecoder::closeSpill() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (spillFd >= 0) {
+        ::close(spillFd);
+    }
+#endif
+    spillFd = -1;
+}
+
+void BoundedDecoder::overflow(const FrameHeader& header, DropReason reason) {
+    if (options.overflow == Overflow::Reject) {
+        if (reason == DropReason::BudgetExhausted) {
+            throw PacketException("receive budget exhausted for " + std::to_string(header.packetLength) + " byte frame");
+        }
+        throw PayloadTooLargeException(static_cast<size_t>(header.packetLength), static_cast<size_t>(options.maxFrameSize));
+    }
+    if (options.overflow == Overflow::Spill && header.packetLength <= options.maxSpillSize) {
+#if defined(__unix__) || defined(__APPLE__)
+        spillFd = detail::openSpillFile(options.spillDirectory, "streamprotocol-spill");
+        mode = Mode::Spill;
+        return;
+#endif
+    }
+    mode = Mode::Discard;
+    ++stats.framesDropped;
+    stats.bytesDropped += header.packetLength;
+    if (callbacks.onDropped) {
+        callbacks.onDropped(header, options.overflow == Overflow::Spill ? DropReason::SpillTooLarge : reason);
+    }
+}
+
+void BoundedDecoder::onHeader(const FrameHeader& header) {
+    // 여기까지는 헤더 8바이트만 받은 상태입니다. 할당 여부를 선언된 길이로만 결정합니다.
+    closeSpill();
+    current.header = header;
+    current.payload = std::vector<uint8_t>();
+    current.lease = ReceiveBudget::Lease();
+
+    if (header.packetLength > options.maxFrameSize) {
+        overflow(header, DropReason::FrameTooLarge);
+        return;
+    }
+    uint64_t payloadSize = header.PayloadSize();
+    if (budget != nullptr) {
+        current.lease = budget->tryAcquire(payloadSize);
+        if (!current.lease) {
+            overflow(header, DropReason::BudgetExhausted);
+            return;
+        }
+    }
+    current.payload.reserve(static_cast<size_t>(payloadSize));
+    mode = Mode::Buffer;
+}
+
+void BoundedDecoder::onPayload(const uint8_t* data, size_t size) {
+    switch (mode) {
+        case Mode::Buffer:
+            current.payload.insert(current.payload.end(), data, data + size);
+            break;
+        case Mode::Spill:
+#if defined(__unix__) || defined(__APPLE__)
+            while (size > 0) {
+                ssize_t written = ::write(spillFd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throwErrno("write spill file");
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+#endif
+            break;
+        case Mode::Discard:
+            break;
+    }
+}
+
+void BoundedDecoder::onEnd(const FrameHeader& header, bool crcValid) {
+    Mode finished = mode;
+    mode = Mode::Discard;
+    if (finished == Mode::Discard) {
+        return;
+    }
+    if (!crcValid) {
+        ++stats.crcErrors;
+        closeSpill();
+        current.payload = std::vector<uint8_t>();
+        current.lease.release();
+        return;
+    }
+    if (finished == Mode::Spill) {
+        SpilledFrame spilled(spillFd, header, header.PayloadSize());
+        spillFd = -1;
+        ++stats.framesSpilled;
+        callbacks.onSpilled(std::move(spilled));
+        return;
+    }
+    ++stats.framesDelivered;
+    callbacks.onFrame(std::move(current));
+    current = Frame();
+}
+
+void BoundedDecoder::feed(const uint8_t* data, size_t size) {
+    reader.feed(data, size);
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,82 @@
+#include "streamprotocol/Capture.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace streamprotocol {
+
+namespace {
+
+void putU64(uint8_t* dst, uint64_t value) {
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        dst[i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFFu);
+    }
+}
+
+uint64_t getU64(const uint8_t* src) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        value |= static_cast<uint64_t>(src[i]) << (i * 8);
+    }
+    return value;
+}
+
+} // namespace
+
+constexpr char CaptureWriter::MAGIC[9];
+
+CaptureWriter::CaptureWriter(std::ostream& out) : out(out) {
+    out.write(MAGIC, 8);
+    if (!out) {
+        throw std::runtime_error("CaptureWriter: output stream write failed");
+    }
+}
+
+void CaptureWriter::write(uint64_t timestampNs, const uint8_t* frame, size_t size) {
+    if (frame == nullptr && size != 0) {
+        throw std::invalid_argument("frame must not be null");
+    }
+    uint8_t prefix[16];
+    putU64(prefix, timestampNs);
+    putU64(prefix + 8, size);
+    out.write(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+    out.write(reinterpret_cast<const char*>(frame), static_cast<std::streamsize>(size));
+    if (!out) {
+        throw std::runtime_error("CaptureWriter: output stream write failed");
+    }
+}
+
+CaptureReader::CaptureReader(std::istream& in, uint64_t maxFrameSize) : in(in), maxFrameSize(maxFrameSize) {
+    char magic[8];
+    in.read(magic, sizeof(magic));
+    if (in.gcount() != static_cast<std::streamsize>(sizeof(magic)) || std::memcmp(magic, CaptureWriter::MAGIC, 8) != 0) {
+        throw PacketException("Not a StreamProtocol capture file");
+    }
+}
+
+bool CaptureReader::next(CaptureRecord& record) {
+    uint8_t prefix[16];
+    in.read(reinterpret_cast<char*>(prefix), sizeof(prefix));
+    std::streamsize got = in.gcount();
+    if (got == 0) {
+        return false;
+    }
+    if (got != static_cast<std::streamsize>(sizeof(prefix))) {
+        throw PacketException("Truncated capture record");
+    }
+
+    uint64_t size = getU64(prefix + 8);
+    if (size > maxFrameSize) {
+        throw PayloadTooLargeException(size, maxFrameSize);
+    }
+    record.timestampNs = getU64(prefix);
+    record.frame.resize(static_cast<size_t>(size));
+    in.read(reinterpret_cast<char*>(record.frame.data()), static_cast<std::streamsize>(size));
+    if (in.gcount() != static_cast<std::streamsize>(size)) {
+        throw PacketException("Truncated capture record (" + std::to_string(in.gcount()) + " of " +
+                              std::to_string(size) + " bytes)");
+    }
+    return true;
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,266 @@
+#include "streamprotocol/ChannelMux.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr uint8_t MUX_OP_WINDOW_UPDATE = 0x01;
+constexpr size_t MUX_WINDOW_UPDATE_SIZE = 5;   // opcode(1) + increment(4, LE)
+
+} // namespace
+
+ChannelMux::ChannelMux(StreamProtocol& protocol)
+    : ChannelMux(protocol, Options()) {
+}
+
+ChannelMux::ChannelMux(StreamProtocol& protocol, const Options& options)
+    : protocol(protocol), options(options), channels(MAX_CHANNELS) {
+    if (options.initialWindow == 0 || options.quantum == 0) {
+        throw std::invalid_argument("ChannelMux window and quantum must be non-zero");
+    }
+}
+
+ChannelMux::Channel& ChannelMux::channelAt(uint16_t channel) {
+    if (channel >= MAX_CHANNELS) {
+        throw std::invalid_argument("channel must be 10-bit (0-1023)");
+    }
+    std::unique_ptr<Channel>& slot = channels[channel];
+    if (!slot) {
+        slot.reset(new Channel());
+        slot->sendCredit = options.initialWindow;
+    }
+    return *slot;
+}
+
+bool ChannelMux::canSend(const Channel& state, size_t payloadSize) const {
+    // 창보다 큰 프레임은 상대가 이전 데이터를 모두 소비했을 때(크레딧이 가득 찼을 때)만 보냅니다.
+    int64_t window = static_cast<int64_t>(options.initialWindow);
+    if (payloadSize > options.initialWindow) {
+        return state.sendCredit >= window;
+    }
+    return state.sendCredit >= static_cast<int64_t>(payloadSize);
+}
+
+void ChannelMux::schedule(uint16_t channel, Channel& state) {
+    if (state.scheduled || state.sendQueue.empty()) {
+        return;
+    }
+    if (!canSend(state, state.sendQueue.front().size() - StreamProtocol::FRAME_OVERHEAD)) {
+        return;
+    }
+    state.scheduled = true;
+    state.turnStarted = false;
+    state.deficit = 0;
+    activeChannels.push_back(channel);
+}
+
+void ChannelMux::SetWeight(uint16_t channel, uint32_t weight) {
+    if (weight == 0) {
+        throw std::invalid_argument("channel weight must be at least 1");
+    }
+    channelAt(channel).weight = weight;
+}
+
+bool ChannelMux::send(uint16_t channel, const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag) {
+    if (payloadType == PayloadType::MUX_CONTROL) {
+        throw std::invalid_argument("payloadType is reserved for ChannelMux control frames");
+    }
+    Channel& state = channelAt(channel);
+    if (!state.sendQueue.empty() && state.queuedBytes + size > options.maxQueuedSendBytes) {
+        return false;
+    }
+
+    state.sendQueue.push_back(protocol.toBytes(data, size, payloadType, fragFlag, channel));
+    state.queuedBytes += size;
+    schedule(channel, state);
+    return true;
+}
+
+bool ChannelMux::nextFrame(std::vector<uint8_t>& frame) {
+    if (!controlQueue.empty()) {
+        frame = std::move(controlQueue.front());
+        controlQueue.pop_front();
+        return true;
+    }
+
+    while (!activeChannels.empty()) {
+        uint16_t channel = activeChannels.front();
+        Channel& state = *channels[channel];
+
+        size_t payloadSize = state.sendQueue.empty() ? 0 : state.sendQueue.front().size() - StreamProtocol::FRAME_OVERHEAD;
+        if (state.sendQueue.empty() || !canSend(state, payloadSize)) {
+            if (!state.sendQueue.empty()) {
+                ++state.stats.creditStalls;
+            }
+            state.scheduled = false;
+            state.turnStarted = false;
+            state.deficit = 0;
+            activeChannels.pop_front();
+            continue;
+        }
+
+        // 차례가 돌아올 때마다 quantum * weight 만큼 송신 한도를 받습니다.
+        if (!state.turnStarted) {
+            state.deficit += static_cast<int64_t>(options.quantum) * state.weight;
+            state.turnStarted = true;
+        }
+        if (state.deficit < static_cast<int64_t>(payloadSize)) {
+            // 한도가 부족하면 다음 바퀴로 넘깁니다. 남은 한도는 다음 차례에 이어서 씁니다.
+            state.turnStarted = false;
+            activeChannels.pop_front();
+            activeChannels.push_back(channel);
+            continue;
+        }
+
+        frame = std::move(state.sendQueue.front());
+        state.sendQueue.pop_front();
+        state.queuedBytes -= payloadSize;
+        state.sendCredit -= static_cast<int64_t>(payloadSize);
+        state.deficit -= static_cast<int64_t>(payloadSize);
+        ++state.stats.framesSent;
+        state.stats.bytesSent += payloadSize;
+
+        if (state.sendQueue.empty() ||
+            !canSend(state, state.sendQueue.front().size() - StreamProtocol::FRAME_OVERHEAD)) {
+            if (!state.sendQueue.empty()) {
+                ++state.stats.creditStalls;
+            }
+            state.scheduled = false;
+            state.turnStarted = false;
+            state.deficit = 0;
+            activeChannels.pop_front();
+        } else if (state.deficit < static_cast<int64_t>(state.sendQueue.front().size() - StreamProtocol::FRAME_OVERHEAD)) {
+            // 이번 차례의 한도를 다 썼으면 뒤로 보냅니다.
+            state.turnStarted = false;
+            activeChannels.pop_front();
+            activeChannels.push_back(channel);
+        }
+        return true;
+    }
+    return false;
+}
+
+int64_t ChannelMux::SendCredit(uint16_t channel) const {
+    if (channel >= MAX_CHANNELS) {
+        throw std::invalid_argument("channel must be 10-bit (0-1023)");
+    }
+    return channels[channel] ? channels[channel]->sendCredit : static_cast<int64_t>(options.initialWindow);
+}
+
+size_t ChannelMux::QueuedSendBytes(uint16_t channel) const {
+    if (channel >= MAX_CHANNELS) {
+        throw std::invalid_argument("channel must be 10-bit (0-1023)");
+    }
+    return channels[channel] ? channels[channel]->queuedBytes : 0;
+}
+
+void ChannelMux::queueWindowUpdate(uint16_t channel, uint32_t increment) {
+    uint8_t payload[MUX_WINDOW_UPDATE_SIZE];
+    payload[0] = MUX_OP_WINDOW_UPDATE;
+    for (int i = 0; i < 4; ++i) {
+        payload[1 + i] = static_cast<uint8_t>((increment >> (i * 8)) & 0xFFu);
+    }
+    controlQueue.push_back(protocol.toBytes(payload, sizeof(payload), PayloadType::MUX_CONTROL,
+                                            StreamProtocol::UNFRAGED, channel));
+}
+
+void ChannelMux::handleControl(uint16_t channel, const uint8_t* payload, size_t size) {
+    if (size != MUX_WINDOW_UPDATE_SIZE || payload[0] != MUX_OP_WINDOW_UPDATE) {
+        throw PacketException("Unknown ChannelMux control frame on channel " + std::to_string(channel));
+    }
+    uint32_t increment = 0;
+    for (int i = 0; i < 4; ++i) {
+        increment |= static_cast<uint32_t>(payload[1 + i]) << (i * 8);
+    }
+
+    Channel& state = channelAt(channel);
+    state.sendCredit += increment;
+    if (state.sendCredit > static_cast<int64_t>(options.initialWindow)) {
+        throw PacketException("ChannelMux window overflow on channel " + std::to_string(channel));
+    }
+    schedule(channel, state);
+}
+
+void ChannelMux::onFrame(const ParsedPacketView& frame) {
+    if (frame.PayloadType() == PayloadType::MUX_CONTROL) {
+        handleControl(frame.UserField(), frame.Payload(), frame.PayloadSize());
+        return;
+    }
+    onFrame(frame.toParsedPacket());
+}
+
+void ChannelMux::onFrame(ParsedPacket&& frame) {
+    uint16_t channel = frame.UserField();
+    if (frame.PayloadType() == PayloadType::MUX_CONTROL) {
+        handleControl(channel, frame.Payload().data(), frame.Payload().size());
+        return;
+    }
+
+    Channel& state = channelAt(channel);
+    size_t size = frame.Payload().size();
+    bool violates = size > options.initialWindow
+                        ? state.receiveOutstanding != 0
+                        : state.receiveOutstanding + size > options.initialWindow;
+    if (violates) {
+        throw PacketException("ChannelMux flow control violation on channel " + std::to_string(channel) +
+                              ": " + std::to_string(size) + " bytes (outstanding: " +
+                              std::to_string(state.receiveOutstanding) + ")");
+    }
+
+    bool wasEmpty = state.receiveQueue.empty();
+    state.receiveOutstanding += size;
+    state.receiveQueue.push_back(std::move(frame));
+    ++state.stats.framesReceived;
+    state.stats.bytesReceived += size;
+
+    if (wasEmpty && readableCallback) {
+        readableCallback(channel);
+    }
+}
+
+std::optional<ParsedPacket> ChannelMux::receive(uint16_t channel) {
+    Channel& state = channelAt(channel);
+    if (state.receiveQueue.empty()) {
+        return std::nullopt;
+    }
+
+    std::optional<ParsedPacket> frame(std::move(state.receiveQueue.front()));
+    state.receiveQueue.pop_front();
+    state.consumedSinceUpdate += frame->Payload().size();
+
+    // 창의 절반을 소비했거나 대기열을 비웠으면 크레딧을 돌려줍니다.
+    // (대기열이 비었을 때 돌려주지 않으면 창의 절반보다 큰 프레임이 영원히 막힐 수 있습니다.)
+    if (state.consumedSinceUpdate > 0 &&
+        (state.consumedSinceUpdate >= options.initialWindow / 2 || state.receiveQueue.empty())) {
+        uint64_t increment = state.consumedSinceUpdate;
+        state.receiveOutstanding -= increment;
+        state.consumedSinceUpdate = 0;
+        // WINDOW_UPDATE 의 증가량은 32비트이므로, 창보다 큰 프레임을 소비한 경우에는 여러 개로 나누어 보냅니다.
+        while (increment > 0) {
+            uint32_t chunk = static_cast<uint32_t>(std::min<uint64_t>(increment, UINT32_MAX));
+            queueWindowUpdate(channel, chunk);
+            increment -= chunk;
+        }
+    }
+    return frame;
+}
+
+size_t ChannelMux::PendingFrames(uint16_t channel) const {
+    if (channel >= MAX_CHANNELS) {
+        throw std::invalid_argument("channel must be 10-bit (0-1023)");
+    }
+    return channels[channel] ? channels[channel]->receiveQueue.size() : 0;
+}
+
+ChannelMux::ChannelStats ChannelMux::Stats(uint16_t channel) const {
+    if (channel >= MAX_CHANNELS) {
+        throw std::invalid_argument("channel must be 10-bit (0-1023)");
+    }
+    return channels[channel] ? channels[channel]->stats : ChannelStats();
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,328 @@
+#include "streamprotocol/Compression.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "Detail.hpp"
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr size_t LZ_LAST_LITERALS = 5;     // 블록 끝 5바이트는 항상 리터럴로 남깁니다.
+constexpr size_t LZ_MF_LIMIT = 12;         // 이보다 짧게 남으면 매치를 찾지 않습니다.
+constexpr size_t LZ_MAX_OFFSET = 0xFFFF;
+constexpr int LZ_HASH_BITS = 12;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t lzHash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// 15 이상인 길이를 255 단위 확장 바이트로 씁니다.
+inline bool writeLength(uint8_t*& op, const uint8_t* oend, size_t length) {
+    while (length >= 255) {
+        if (op >= oend) return false;
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= oend) return false;
+    *op++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+inline bool readLength(const uint8_t*& ip, const uint8_t* iend, size_t& length) {
+    uint8_t b;
+    do {
+        if (ip >= iend) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+bool emitSequence(uint8_t*& op, const uint8_t* oend,
+                  const uint8_t* literals, size_t literalLength,
+                  size_t offset, size_t matchLength) {
+    if (op >= oend) return false;
+    uint8_t* token = op++;
+    uint8_t litNibble = literalLength >= 15 ? 15 : static_cast<uint8_t>(literalLength);
+    *token = static_cast<uint8_t>(litNibble << 4);
+    if (literalLength >= 15 && !writeLength(op, oend, literalLength - 15)) return false;
+
+    if (static_cast<size_t>(oend - op) < literalLength) return false;
+    if (literalLength != 0) {
+        std::memcpy(op, literals, literalLength);     // 빈 입력이면 literals 가 nullptr 일 수 있습니다.
+    }
+    op += literalLength;
+
+    if (matchLength == 0) {
+        return true; // 마지막 리터럴 전용 시퀀스
+    }
+
+    if (oend - op < 2) return false;
+    *op++ = static_cast<uint8_t>(offset & 0xFFu);
+    *op++ = static_cast<uint8_t>((offset >> 8) & 0xFFu);
+
+    size_t ml = matchLength - LZ_MIN_MATCH;
+    *token |= ml >= 15 ? 15 : static_cast<uint8_t>(ml);
+    if (ml >= 15 && !writeLength(op, oend, ml - 15)) return false;
+    return true;
+}
+
+} // namespace
+
+size_t LZCodec::maxCompressedSize(size_t rawSize) const {
+    return rawSize + rawSize / 255 + 16;
+}
+
+size_t LZCodec::compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) const {
+    uint8_t* op = dst;
+    const uint8_t* oend = dst + dstCapacity;
+    size_t anchor = 0;
+
+    if (srcSize > LZ_MF_LIMIT) {
+        uint32_t table[1u << LZ_HASH_BITS] = {};
+        const size_t matchLimit = srcSize - LZ_MF_LIMIT;
+        const size_t extendLimit = srcSize - LZ_LAST_LITERALS;
+        size_t ip = 0;
+
+        while (ip < matchLimit) {
+            uint32_t sequence = read32(src + ip);
+            uint32_t h = lzHash(sequence);
+            size_t ref = table[h];
+            table[h] = static_cast<uint32_t>(ip);
+
+            if (ref < ip && ip - ref <= LZ_MAX_OFFSET && read32(src + ref) == sequence) {
+                size_t matchLength = LZ_MIN_MATCH;
+                while (ip + matchLength < extendLimit && src[ref + matchLength] == src[ip + matchLength]) {
+                    ++matchLength;
+                }
+                if (!emitSequence(op, oend, src + anchor, ip - anchor, ip - ref, matchLength)) {
+                    return 0;
+                }
+                ip += matchLength;
+                anchor = ip;
+                if (ip < matchLimit) {
+                    // 매치 직전 위치도 테이블에 넣어 다음 매치 확률을 높입니다.
+                    table[lzHash(read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+                }
+            } else {
+                // 매치가 계속 실패하면 보폭을 늘려 압축 불가능한 데이터를 빨리 지나갑니다.
+                ip += 1 + ((ip - anchor) >> 6);
+            }
+        }
+    }
+
+    if (!emitSequence(op, oend, src + anchor, srcSize - anchor, 0, 0)) {
+        return 0;
+    }
+    return static_cast<size_t>(op - dst);
+}
+
+void LZCodec::decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t rawSize) const {
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + rawSize;
+
+    while (true) {
+        if (ip >= iend) {
+            throw PacketException("Truncated LZ block");
+        }
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(ip, iend, literalLength)) {
+            throw PacketException("Truncated LZ literal length");
+        }
+        if (static_cast<size_t>(iend - ip) < literalLength || static_cast<size_t>(oend - op) < literalLength) {
+            throw PacketException("LZ literal run out of bounds");
+        }
+        if (literalLength != 0) {
+            std::memcpy(op, ip, literalLength);
+        }
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == iend) {
+            break; // 마지막 시퀀스
+        }
+
+        if (iend - ip < 2) {
+            throw PacketException("Truncated LZ match offset");
+        }
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            throw PacketException("Invalid LZ match offset");
+        }
+
+        size_t matchLength = token & 0x0Fu;
+        if (matchLength == 15 && !readLength(ip, iend, matchLength)) {
+            throw PacketException("Truncated LZ match length");
+        }
+        matchLength += LZ_MIN_MATCH;
+        if (static_cast<size_t>(oend - op) < matchLength) {
+            throw PacketException("LZ match out of bounds");
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // 겹치는 매치는 반복 패턴이므로 바이트 단위로 복사합니다.
+            for (size_t i = 0; i < matchLength; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    if (op != oend) {
+        throw PacketException("LZ block size mismatch: " + std::to_string(op - dst) +
+                              " bytes (expected: " + std::to_string(rawSize) + ")");
+    }
+}
+
+PayloadCompressor::PayloadCompressor(StreamProtocol& protocol)
+    : protocol(protocol) {
+    registerCodec(PayloadType::COMPRESSED_LZ, std::make_shared<LZCodec>());
+    SetEncodeCodec(PayloadType::COMPRESSED_LZ);
+}
+
+const PayloadCodec* PayloadCompressor::findCodec(uint8_t payloadType) const {
+    for (const Entry& entry : codecs) {
+        if (entry.payloadType == payloadType) {
+            return entry.codec.get();
+        }
+    }
+    return nullptr;
+}
+
+void PayloadCompressor::registerCodec(uint8_t payloadType, std::shared_ptr<const PayloadCodec> codec) {
+    // 압축 프레임은 수신 측이 payloadType 만 보고 코덱을 고르므로, 애플리케이션 타입(0x00~0x07)과 겹치면 안 됩니다.
+    if (!PayloadType::IsReserved(payloadType)) {
+        throw std::invalid_argument("codec payloadType must be in the reserved range (0x08-0x0F)");
+    }
+    if (!codec) {
+        throw std::invalid_argument("codec must not be null");
+    }
+    for (Entry& entry : codecs) {
+        if (entry.payloadType == payloadType) {
+            if (encodeCodec == entry.codec.get()) {
+                encodeCodec = codec.get();
+            }
+            entry.codec = std::move(codec);
+            return;
+        }
+    }
+    codecs.push_back(Entry{ payloadType, std::move(codec) });
+}
+
+void PayloadCompressor::SetEncodeCodec(uint8_t payloadType) {
+    const PayloadCodec* codec = findCodec(payloadType);
+    if (codec == nullptr) {
+        throw std::invalid_argument("No codec registered for payloadType " + std::to_string(payloadType));
+    }
+    encodeCodec = codec;
+    encodeType = payloadType;
+}
+
+void PayloadCompressor::DisableEncoding() {
+    encodeCodec = nullptr;
+}
+
+std::vector<uint8_t> PayloadCompressor::toBytes(const uint8_t* data, size_t size, uint8_t payloadType,
+                                                uint8_t fragFlag, uint16_t userValue) {
+    if (data == nullptr) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    if (payloadType > 0x0F) {
+        throw std::invalid_argument("payloadType must be 4 bits (0-15)");
+    }
+
+    if (encodeCodec != nullptr && size >= minPayloadSize && size > minSavings) {
+        scratch.resize(1 + detail::MAX_VARINT_SIZE);
+        scratch[0] = payloadType;
+        size_t prefixSize = 1 + detail::writeVarint(scratch.data() + 1, size);
+
+        // 원본보다 minSavings 이상 작아지지 않으면 코덱이 0 을 반환하도록 출력 한도를 줍니다.
+        size_t budget = size - minSavings;
+        if (budget > prefixSize) {
+            size_t capacity = budget - prefixSize;
+            scratch.resize(prefixSize + capacity);
+            size_t compressedSize = encodeCodec->compress(data, size, scratch.data() + prefixSize, capacity);
+            if (compressedSize != 0) {
+                return protocol.toBytes(scratch.data(), prefixSize + compressedSize, encodeType, fragFlag, userValue);
+            }
+        }
+    }
+
+    return protocol.toBytes(data, size, payloadType, fragFlag, userValue);
+}
+
+std::vector<uint8_t> PayloadCompressor::toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue) {
+    return toBytes(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), PayloadType::STRING, fragFlag, userValue);
+}
+
+size_t PayloadCompressor::decompressedSize(const uint8_t* payload, size_t size, uint8_t payloadType) const {
+    if (findCodec(payloadType) == nullptr) {
+        return size;
+    }
+    if (size < 2) {
+        throw PacketException("Compressed payload too short");
+    }
+    size_t pos = 1;
+    uint64_t rawSize = detail::readVarint(payload, size, pos, "Malformed compressed payload length");
+    if (rawSize > maxDecompressedSize) {
+        throw PayloadTooLargeException(static_cast<size_t>(rawSize), maxDecompressedSize);
+    }
+    return static_cast<size_t>(rawSize);
+}
+
+uint8_t PayloadCompressor::decompressInto(const uint8_t* payload, size_t size, uint8_t payloadType,
+                                          uint8_t* dst, size_t dstCapacity, size_t& written) const {
+    const PayloadCodec* codec = findCodec(payloadType);
+    if (codec == nullptr) {
+        if (size > dstCapacity) {
+            throw BufferTooSmallException(dstCapacity);
+        }
+        if (size > 0) {
+            std::memcpy(dst, payload, size);
+        }
+        written = size;
+        return payloadType;
+    }
+
+    size_t rawSize = decompressedSize(payload, size, payloadType);
+    if (rawSize > dstCapacity) {
+        throw BufferTooSmallException(dstCapacity);
+    }
+    size_t prefixSize = 1;
+    detail::readVarint(payload, size, prefixSize, "Malformed compressed payload length");
+    uint8_t innerType = payload[0];
+    if (innerType > 0x0F) {
+        throw PacketException("Invalid inner payloadType in compressed payload");
+    }
+
+    codec->decompress(payload + prefixSize, size - prefixSize, dst, rawSize);
+    written = rawSize;
+    return innerType;
+}
+
+uint8_t PayloadCompressor::decompress(const ParsedPacket& packet, std::vector<uint8_t>& out) const {
+    const std::vector<uint8_t>& payload = packet.Payload();
+    size_t rawSize = decompressedSize(payload.data(), payload.size(), packet.PayloadType());
+    out.resize(rawSize);
+    size_t written = 0;
+    return decompressInto(payload.data(), payload.size(), packet.PayloadType(), out.data(), out.size(), written);
+}
+
+} // namespace streamprotocol
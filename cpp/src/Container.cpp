@@ -0,0 +1,194 @@
+#include "streamprotocol/Container.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "streamprotocol/PacketException.h"
+
+#include "Detail.hpp"
+
+namespace streamprotocol {
+
+namespace {
+
+/// data 에서 레코드 하나를 읽고 소비한 바이트 수를 반환합니다. 잘리거나 잘못된 레코드는 PacketException.
+size_t decodeRecord(const uint8_t* data, size_t available, ContainerRecord& record) {
+    if (available < ContainerBuilder::RECORD_TAG_SIZE) {
+        throw PacketException("Truncated container record tag");
+    }
+    uint16_t tag = static_cast<uint16_t>(data[0] | (data[1] << 8));
+    if ((tag & 0xC000u) != 0) {
+        throw PacketException("Container record uses reserved tag bits");
+    }
+    record.userField = static_cast<uint16_t>(tag & 0x3FFu);
+    record.payloadType = static_cast<uint8_t>((tag >> 10) & 0x0Fu);
+
+    size_t pos = ContainerBuilder::RECORD_TAG_SIZE;
+    uint64_t length = detail::readVarint(data, available, pos, "Malformed container record length");
+    if (length > available - pos) {
+        throw PacketException("Container record exceeds frame: " + std::to_string(length) + " bytes (remaining: " +
+                              std::to_string(available - pos) + ")");
+    }
+    record.data = data + pos;
+    record.size = static_cast<size_t>(length);
+    return pos + record.size;
+}
+
+} // namespace
+
+ContainerReader::Iterator::Iterator(const uint8_t* begin, const uint8_t* end)
+    : cursor(begin), limit(end) {
+    load();
+}
+
+void ContainerReader::Iterator::load() {
+    // ContainerReader 가 생성 시 구조를 검증했으므로 여기서는 예외가 나지 않습니다.
+    next = cursor == limit ? 0 : decodeRecord(cursor, static_cast<size_t>(limit - cursor), record);
+}
+
+ContainerReader::Iterator& ContainerReader::Iterator::operator++() {
+    cursor += next;
+    load();
+    return *this;
+}
+
+ContainerReader::ContainerReader(const ParsedPacketView& frame)
+    : ContainerReader(frame.Payload(), frame.PayloadSize()) {
+    if (frame.PayloadType() != PayloadType::CONTAINER) {
+        throw std::invalid_argument("frame is not a container (payloadType " + std::to_string(frame.PayloadType()) + ")");
+    }
+}
+
+ContainerReader::ContainerReader(const uint8_t* payload, size_t size)
+    : payload(payload), size(size) {
+    if (payload == nullptr && size != 0) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    ContainerRecord record;
+    for (size_t pos = 0; pos < size; ++count) {
+        pos += decodeRecord(payload + pos, size - pos, record);
+    }
+}
+
+size_t ContainerBuilder::RecordSize(size_t dataSize) {
+    return RECORD_TAG_SIZE + detail::varintSize(dataSize) + dataSize;
+}
+
+ContainerBuilder::ContainerBuilder(StreamProtocol& protocol, Sink sink)
+    : ContainerBuilder(protocol, std::move(sink), Options()) {
+}
+
+ContainerBuilder::ContainerBuilder(StreamProtocol& protocol, Sink sink, const Options& options)
+    : protocol(protocol), sink(std::move(sink)), options(options), buffer(options.maxPayloadSize) {
+    if (!this->sink) {
+        throw std::invalid_argument("sink must not be empty");
+    }
+    if (options.maxRecords == 0) {
+        throw std::invalid_argument("maxRecords must be at least 1");
+    }
+    if (options.userField > 0x3FF) {
+        throw std::invalid_argument("userField must be 10-bit (0-1023)");
+    }
+    if (options.maxPayloadSize > StreamProtocol::MAX_PAYLOAD_LENGTH) {
+        throw std::invalid_argument("maxPayloadSize exceeds the maximum frame payload");
+    }
+}
+
+ContainerBuilder::ContainerBuilder(StreamProtocol& protocol, SendCoalescer& coalescer, const Options& options)
+    : ContainerBuilder(protocol, [&coalescer](std::vector<uint8_t>&& frame) { coalescer.enqueue(std::move(frame)); },
+                       options) {
+}
+
+bool ContainerBuilder::add(const uint8_t* data, size_t size, uint8_t payloadType, uint16_t userField,
+                           Clock::time_point now) {
+    if (data == nullptr && size != 0) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    if (payloadType > 0x0F || payloadType == PayloadType::CONTAINER) {
+        throw std::invalid_argument("record payloadType must be 0-15 and not CONTAINER");
+    }
+    if (userField > 0x3FF) {
+        throw std::invalid_argument("userField must be 10-bit (0-1023)");
+    }
+
+    bool emitted = false;
+    size_t recordSize = RecordSize(size);
+    if (recordSize > options.maxPayloadSize) {
+        // 혼자서도 컨테이너에 들어가지 않는 레코드: 순서를 지키기 위해 대기 중인 레코드를 먼저 내보냅니다.
+        if (pendingRecords != 0) {
+            emit();
+        }
+        sink(protocol.toBytes(data, size, payloadType, StreamProtocol::UNFRAGED, userField));
+        stats.oversized++;
+        return true;
+    }
+    if (pendingRecords != 0 && buffer.PayloadSize() + recordSize > options.maxPayloadSize) {
+        emit();
+        emitted = true;
+    }
+
+    size_t offset = buffer.PayloadSize();
+    buffer.resize(offset + RECORD_TAG_SIZE + detail::varintSize(size) + size);
+    uint8_t* out = buffer.Payload() + offset;
+    uint16_t tag = static_cast<uint16_t>(userField | (static_cast<uint16_t>(payloadType) << 10));
+    out[0] = static_cast<uint8_t>(tag & 0xFFu);
+    out[1] = static_cast<uint8_t>(tag >> 8);
+    size_t header = RECORD_TAG_SIZE + detail::writeVarint(out + RECORD_TAG_SIZE, size);
+    if (size != 0) {
+        std::memcpy(out + header, data, size);
+    }
+
+    if (pendingRecords == 0) {
+        firstType = payloadType;
+        firstUser = userField;
+        firstDataOffset = offset + header;
+        deadline = now + options.maxDelay;
+    }
+    ++pendingRecords;
+    pendingTagBytes += header;
+
+    if (pendingRecords >= options.maxRecords || options.maxDelay <= std::chrono::nanoseconds::zero()) {
+        emit();
+        emitted = true;
+    }
+    return emitted;
+}
+
+bool ContainerBuilder::poll(Clock::time_point now) {
+    if (pendingRecords == 0 || deadline > now) {
+        return false;
+    }
+    emit();
+    return true;
+}
+
+void ContainerBuilder::flush() {
+    if (pendingRecords != 0) {
+        emit();
+    }
+}
+
+void ContainerBuilder::emit() {
+    if (pendingRecords == 1) {
+        // 레코드 하나는 태그를 벗겨 일반 프레임으로 보냅니다.
+        size_t size = buffer.PayloadSize() - firstDataOffset;
+        sink(protocol.toBytes(buffer.Payload() + firstDataOffset, size, firstType, StreamProtocol::UNFRAGED, firstUser));
+        stats.single++;
+        buffer.clear();
+    } else {
+        // 레코드마다 프레임을 만들면 레코드당 FRAME_OVERHEAD, 컨테이너는 FRAME_OVERHEAD 한 번 + 레코드 태그/길이
+        size_t separate = pendingRecords * StreamProtocol::FRAME_OVERHEAD;
+        size_t framing = StreamProtocol::FRAME_OVERHEAD + pendingTagBytes;
+        stats.savedBytes += separate > framing ? separate - framing : 0;
+        stats.containers++;
+        stats.records += pendingRecords;
+        sink(protocol.toBytes(std::move(buffer), PayloadType::CONTAINER, StreamProtocol::UNFRAGED, options.userField));
+        buffer.reserve(options.maxPayloadSize);
+    }
+    pendingRecords = 0;
+    pendingTagBytes = 0;
+    deadline = Clock::time_point::max();
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,654 @@
+#include "streamprotocol/CoreServer.hpp"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "streamprotocol/PacketException.h"
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr int MAX_EVENTS = 64;
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// 샤드 스레드만 쓰는 카운터이므로 잠금 접두사가 붙는 fetch_add 대신 load + store 로 올립니다.
+inline void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
+
+/// start() 가 호출자 스레드에서 열어 샤드 스레드에 넘기는 디스크립터입니다.
+struct CoreServer::Descriptors {
+    int listener = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+
+    void close() {
+        for (int* fd : { &listener, &epollFd, &wakeFd }) {
+            if (*fd >= 0) {
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+};
+
+/// start() 와 샤드 스레드가 준비 단계에서 주고받는 상태입니다.
+/// 샤드 스레드는 자기 샤드를 만든 뒤 arrived 를 올리고, start() 가 핸들러를 채우고 proceed 를 정할 때까지 기다립니다.
+struct CoreServer::Startup {
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t arrived = 0;
+    std::exception_ptr error;       // 샤드 스레드 쪽 준비 실패 (할당 실패 등)
+    bool decided = false;
+    bool proceed = false;
+};
+
+struct CoreServer::Shard::Connection {
+    std::vector<uint8_t> in;
+    size_t filled = 0;
+    std::vector<uint8_t> out;
+    size_t outOffset = 0;
+    bool writeInterest = false;
+    bool dispatching = false;
+    bool closeRequested = false;
+};
+
+CoreServer::Shard::Shard(const CoreServer& server, size_t index, int cpu)
+    : server(server), index(index), cpu(cpu) {
+}
+
+CoreServer::Shard::~Shard() {
+    closeDescriptors();
+}
+
+void CoreServer::Shard::closeDescriptors() {
+    for (int* fd : { &listener, &epollFd, &wakeFd }) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+std::vector<uint8_t> CoreServer::Shard::takeBuffer() {
+    if (bufferPool.empty()) {
+        return std::vector<uint8_t>(server.options.readBufferSize);
+    }
+    std::vector<uint8_t> buffer(std::move(bufferPool.back()));
+    bufferPool.pop_back();
+    return buffer;
+}
+
+void CoreServer::Shard::returnBuffer(std::vector<uint8_t>&& buffer) {
+    // 큰 프레임 때문에 늘어난 버퍼는 풀에 남기지 않습니다.
+    if (bufferPool.size() < server.options.pooledBuffers && buffer.size() == server.options.readBufferSize) {
+        bufferPool.push_back(std::move(buffer));
+    }
+}
+
+void CoreServer::Shard::run() {
+    epoll_event events[MAX_EVENTS];
+    bool stopping = false;
+    while (!stopping) {
+        int ready = ::epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("epoll_wait");
+        }
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                stopping = true;
+            } else if (fd == listener) {
+                acceptAll();
+            } else if (static_cast<size_t>(fd) < connections.size() && connections[fd]) {
+                if (events[i].events & EPOLLOUT) {
+                    flushOutput(fd);
+                }
+                // 끊긴 연결(EPOLLHUP/EPOLLERR/EPOLLRDHUP)도 남은 데이터를 읽은 뒤 read() 가 0 이나 오류를 반환할 때 닫습니다.
+                if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && connections[fd]) {
+                    readFrom(fd);
+                }
+            }
+        }
+    }
+}
+
+void CoreServer::Shard::closeConnections() {
+    for (size_t fd = 0; fd < connections.size(); ++fd) {
+        if (connections[fd]) {
+            closeFd(static_cast<int>(fd));
+        }
+    }
+}
+
+void CoreServer::Shard::acceptAll() {
+    for (;;) {
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            // EAGAIN: 대기 중인 연결을 다 받음. EMFILE 등은 다음 이벤트에서 다시 시도합니다.
+            return;
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        if (static_cast<size_t>(fd) >= connections.size()) {
+            connections.resize(std::max(connections.size() * 2, static_cast<size_t>(fd) + 1));
+        }
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->in = takeBuffer();
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[fd] = std::move(connection);
+        bump(counters.accepted);
+        if (handlers.onOpen) {
+            handlers.onOpen(*this, fd);
+        }
+    }
+}
+
+void CoreServer::Shard::readFrom(int fd) {
+    Connection& connection = *connections[fd];
+    for (;;) {
+        ssize_t n = ::read(fd, connection.in.data() + connection.filled, connection.in.size() - connection.filled);
+        if (n > 0) {
+            connection.filled += static_cast<size_t>(n);
+            bump(counters.bytesIn, static_cast<uint64_t>(n));
+            dispatch(fd, connection);
+            return;     // 레벨 트리거: 남은 데이터는 다음 epoll_wait 에서 읽어 연결 간 공정성을 지킵니다.
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        closeFd(fd);
+        return;
+    }
+}
+
+bool CoreServer::Shard::dispatch(int fd, Connection& connection) {
+    const StreamProtocol& protocol = server.protocol;
+    size_t pos = 0;
+    bool open = true;
+
+    connection.dispatching = true;
+    while (connection.filled - pos >= StreamProtocol::HEADER_SIZE && !connection.closeRequested) {
+        const uint8_t* frame = connection.in.data() + pos;
+        size_t length;
+        try {
+            FrameHeader header = protocol.decodeHeader(frame);
+            if (header.packetLength > server.options.maxPacketLength) {
+                throw PayloadTooLargeException(header.packetLength, server.options.maxPacketLength);
+            }
+            length = static_cast<size_t>(header.packetLength);
+        } catch (const PacketException&) {
+            // 헤더가 잘못되면 이후 프레임 경계를 믿을 수 없으므로 연결을 끊습니다.
+            bump(counters.protocolErrors);
+            connection.closeRequested = true;
+            break;
+        }
+
+        if (connection.filled - pos < length) {
+            break;
+        }
+        ParsedPacketView view;
+        try {
+            view = protocol.parsePacketView(frame, length);
+        } catch (const InvalidCRCException&) {
+            bump(counters.crcErrors);
+            pos += length;
+            continue;
+        }
+        bump(counters.frames);
+        handlers.onFrame(*this, fd, view);
+        pos += length;
+    }
+    connection.dispatching = false;
+
+    if (connection.closeRequested) {
+        closeFd(fd);
+        open = false;
+    } else {
+        if (pos != 0) {
+            std::memmove(connection.in.data(), connection.in.data() + pos, connection.filled - pos);
+            connection.filled -= pos;
+        }
+        // 버퍼보다 큰 프레임이 들어오는 중이면 그 프레임이 들어갈 만큼 늘립니다. (길이는 위에서 검증됨)
+        if (connection.filled >= StreamProtocol::HEADER_SIZE) {
+            size_t length = static_cast<size_t>(protocol.decodeHeader(connection.in.data()).packetLength);
+            if (length > connection.in.size()) {
+                connection.in.resize(length);
+            }
+        }
+    }
+    return open;
+}
+
+void CoreServer::Shard::updateInterest(int fd, Connection& connection, bool wantWrite) {
+    if (connection.writeInterest == wantWrite) {
+        return;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == 0) {
+        connection.writeInterest = wantWrite;
+    }
+}
+
+bool CoreServer::Shard::send(int fd, const uint8_t* frame, size_t size) {
+    if (fd < 0 || static_cast<size_t>(fd) >= connections.size() || !connections[fd]) {
+        return false;
+    }
+    if (frame == nullptr && size != 0) {
+        throw std::invalid_argument("frame must not be null");
+    }
+    Connection& connection = *connections[fd];
+    if (connection.closeRequested) {
+        return false;
+    }
+
+    // 프레임 일부만 쓴 뒤 거절하면 상대의 프레임 경계가 어긋나므로, 상한은 한 바이트도 쓰기 전에 확인합니다.
+    size_t pending = connection.out.size() - connection.outOffset;
+    if (pending + size > server.options.maxOutputBuffer) {
+        return false;
+    }
+    if (pending == 0) {
+        // 밀린 출력이 없으면 바로 씁니다. (대부분의 응답은 여기서 끝남)
+        while (size > 0) {
+            ssize_t n = ::send(fd, frame, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n > 0) {
+                bump(counters.bytesOut, static_cast<uint64_t>(n));
+                frame += n;
+                size -= static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            close(fd);
+            return false;
+        }
+        if (size == 0) {
+            return true;
+        }
+    }
+
+    if (connection.outOffset != 0 && connection.outOffset == connection.out.size()) {
+        connection.out.clear();
+        connection.outOffset = 0;
+    }
+    connection.out.insert(connection.out.end(), frame, frame + size);
+    updateInterest(fd, connection, true);
+    return true;
+}
+
+void CoreServer::Shard::flushOutput(int fd) {
+    Connection& connection = *connections[fd];
+    while (connection.outOffset < connection.out.size()) {
+        ssize_t n = ::send(fd, connection.out.data() + connection.outOffset, connection.out.size() - connection.outOffset,
+                           MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            bump(counters.bytesOut, static_cast<uint64_t>(n));
+            connection.outOffset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        closeFd(fd);
+        return;
+    }
+    connection.out.clear();
+    connection.outOffset = 0;
+    updateInterest(fd, connection, false);
+}
+
+void CoreServer::Shard::close(int fd) {
+    if (fd < 0 || static_cast<size_t>(fd) >= connections.size() || !connections[fd]) {
+        return;
+    }
+    if (connections[fd]->dispatching) {
+        // 이 연결의 수신 버퍼를 가리키는 프레임을 처리하는 중이므로, 디스패치가 끝난 뒤에 닫습니다.
+        connections[fd]->closeRequested = true;
+        return;
+    }
+    closeFd(fd);
+}
+
+void CoreServer::Shard::closeFd(int fd) {
+    std::unique_ptr<Connection> connection(std::move(connections[fd]));
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    bump(counters.closed);
+    if (handlers.onClose) {
+        handlers.onClose(*this, fd);
+    }
+    returnBuffer(std::move(connection->in));
+}
+
+size_t CoreServer::Shard::OpenConnections() const {
+    return static_cast<size_t>(std::count_if(connections.begin(), connections.end(),
+                                             [](const std::unique_ptr<Connection>& c) { return c != nullptr; }));
+}
+
+CoreServer::CoreServer(const StreamProtocol& protocol, HandlerFactory factory)
+    : CoreServer(protocol, std::move(factory), Options()) {
+}
+
+CoreServer::CoreServer(const StreamProtocol& protocol, HandlerFactory factory, const Options& options)
+    : protocol(protocol), factory(std::move(factory)), options(options) {
+    if (!this->factory) {
+        throw std::invalid_argument("handler factory must not be empty");
+    }
+    if (options.readBufferSize < StreamProtocol::FRAME_OVERHEAD) {
+        throw std::invalid_argument("readBufferSize must hold at least a header and CRC");
+    }
+    if (options.maxPacketLength < StreamProtocol::FRAME_OVERHEAD) {
+        throw std::invalid_argument("maxPacketLength must be at least 12");
+    }
+}
+
+CoreServer::~CoreServer() {
+    try {
+        stop();
+    } catch (...) {
+        // 소멸자에서는 샤드 오류를 전달할 곳이 없습니다. 받으려면 먼저 stop() 을 호출하십시오.
+    }
+}
+
+int CoreServer::openListener(uint16_t port) const {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throwErrno("socket");
+    }
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "setsockopt SO_REUSEPORT");
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (options.host.empty()) {
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+    } else if (::inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        ::close(fd);
+        throw std::invalid_argument("host must be an IPv4 address: " + options.host);
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, options.backlog) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "bind/listen port " + std::to_string(port));
+    }
+    return fd;
+}
+
+void CoreServer::shardThread(size_t index, int cpu, const Descriptors& descriptors,
+                             const std::shared_ptr<Startup>& startup) {
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+            cpu = -1;   // 허용되지 않은 CPU (cgroup/cpuset 제한 등): 고정 없이 계속합니다.
+        }
+    }
+
+    // 고정한 뒤에 할당하므로 샤드 객체(통계), 연결 표, 버퍼 풀은 이 CPU 의 NUMA 노드에 놓입니다.
+    std::unique_ptr<Shard> shard;
+    std::exception_ptr error;
+    try {
+        shard.reset(new Shard(*this, index, cpu));
+        shard->listener = descriptors.listener;
+        shard->epollFd = descriptors.epollFd;
+        shard->wakeFd = descriptors.wakeFd;
+        shard->connections.resize(1024);
+        shard->bufferPool.reserve(options.pooledBuffers);
+    } catch (...) {
+        error = std::current_exception();
+        if (!shard) {
+            Descriptors owned = descriptors;
+            owned.close();
+        }
+        shard.reset();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(startup->mutex);
+        if (shard) {
+            shards[index] = std::move(shard);
+        } else if (!startup->error) {
+            startup->error = error;
+        }
+        ++startup->arrived;
+        startup->changed.notify_all();
+        startup->changed.wait(lock, [&startup] { return startup->decided; });
+        if (!startup->proceed) {
+            return;
+        }
+    }
+
+    // 샤드 스레드에서 난 예외는 std::terminate 대신 stop() 으로 넘깁니다.
+    Shard& self = *shards[index];
+    try {
+        self.run();
+    } catch (...) {
+        self.failure = std::current_exception();
+        // 리스너가 열려 있으면 커널이 아무도 받지 않을 연결을 계속 배정하므로, 바로 닫아 남은 샤드로 넘깁니다.
+        ::close(self.listener);
+        self.listener = -1;
+    }
+    self.closeConnections();
+}
+
+void CoreServer::start() {
+    if (running.load()) {
+        throw std::logic_error("CoreServer already started");
+    }
+
+    size_t count = options.shards;
+    if (count == 0) {
+        count = !options.cpus.empty() ? options.cpus.size() : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 리스너와 epoll 은 여기서 만들어 실패를 호출자에게 바로 알립니다. 이후 각 샤드 스레드만 사용합니다.
+    std::vector<Descriptors> descriptors(count);
+    uint16_t port = options.port;
+    try {
+        for (Descriptors& shard : descriptors) {
+            shard.listener = openListener(port);
+            if (port == 0) {
+                sockaddr_in bound{};
+                socklen_t length = sizeof(bound);
+                if (::getsockname(shard.listener, reinterpret_cast<sockaddr*>(&bound), &length) != 0) {
+                    throwErrno("getsockname");
+                }
+                port = ntohs(bound.sin_port);
+            }
+            shard.epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+            shard.wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (shard.epollFd < 0 || shard.wakeFd < 0) {
+                throwErrno("epoll_create1/eventfd");
+            }
+            for (int fd : { shard.listener, shard.wakeFd }) {
+                epoll_event event{};
+                event.events = EPOLLIN;
+                event.data.fd = fd;
+                if (::epoll_ctl(shard.epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                    throwErrno("epoll_ctl");
+                }
+            }
+        }
+    } catch (...) {
+        for (Descriptors& shard : descriptors) {
+            shard.close();
+        }
+        throw;
+    }
+
+    // 샤드 객체는 각 스레드가 CPU 에 고정된 뒤 만들고, 핸들러는 여기(호출자 스레드)서 만들어 검증합니다.
+    shards.clear();
+    shards.resize(count);
+    std::shared_ptr<Startup> startup = std::make_shared<Startup>();
+    std::exception_ptr error;
+    size_t launched = 0;
+    try {
+        threads.reserve(count);
+        for (; launched < count; ++launched) {
+            int cpu = -1;
+            if (options.pinThreads) {
+                cpu = options.cpus.empty()
+                          ? static_cast<int>(launched % std::max(1u, std::thread::hardware_concurrency()))
+                          : options.cpus[launched % options.cpus.size()];
+            }
+            threads.emplace_back(&CoreServer::shardThread, this, launched, cpu, descriptors[launched], startup);
+        }
+    } catch (...) {
+        error = std::current_exception();
+        for (size_t i = launched; i < count; ++i) {
+            descriptors[i].close();
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(startup->mutex);
+        startup->changed.wait(lock, [&] { return startup->arrived == launched; });
+        if (!error) {
+            error = startup->error;
+        }
+        if (!error) {
+            try {
+                for (std::unique_ptr<Shard>& shard : shards) {
+                    Handlers handlers = factory(*shard);
+                    if (!handlers.onFrame) {
+                        throw std::invalid_argument("CoreServer handler factory must provide onFrame");
+                    }
+                    shard->handlers = std::move(handlers);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        startup->decided = true;
+        startup->proceed = !error;
+    }
+    startup->changed.notify_all();
+
+    if (error) {
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+        shards.clear();     // 샤드 소멸자가 리스너/epoll/eventfd 를 닫습니다.
+        std::rethrow_exception(error);
+    }
+    boundPort = port;
+    running.store(true);
+}
+
+void CoreServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    for (auto& shard : shards) {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(shard->wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    // 통계를 계속 읽을 수 있도록 샤드 객체는 다음 start() 까지 남기고, 리스너 등만 닫아 포트를 놓습니다.
+    std::exception_ptr failure;
+    for (auto& shard : shards) {
+        shard->closeDescriptors();
+        if (!failure) {
+            failure = shard->failure;
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+CoreServer::ShardStats CoreServer::Stats(size_t shard) const {
+    if (shard >= shards.size()) {
+        throw std::invalid_argument("shard index out of range");
+    }
+    const Shard::Counters& c = shards[shard]->counters;
+    ShardStats stats;
+    stats.accepted = c.accepted.load(std::memory_order_relaxed);
+    stats.closed = c.closed.load(std::memory_order_relaxed);
+    stats.frames = c.frames.load(std::memory_order_relaxed);
+    stats.bytesIn = c.bytesIn.load(std::memory_order_relaxed);
+    stats.bytesOut = c.bytesOut.load(std::memory_order_relaxed);
+    stats.crcErrors = c.crcErrors.load(std::memory_order_relaxed);
+    stats.protocolErrors = c.protocolErrors.load(std::memory_order_relaxed);
+    return stats;
+}
+
+CoreServer::ShardStats CoreServer::TotalStats() const {
+    ShardStats total;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        ShardStats s = Stats(i);
+        total.accepted += s.accepted;
+        total.closed += s.closed;
+        total.frames += s.frames;
+        total.bytesIn += s.bytesIn;
+        total.bytesOut += s.bytesOut;
+        total.crcErrors += s.crcErrors;
+        total.protocolErrors += s.protocolErrors;
+    }
+    return total;
+}
+
+} // namespace streamprotocol
+
+#endif // __linux__
@@ -0,0 +1,202 @@
+#include "streamprotocol/Crc32.hpp"
+
+#include <array>
+#include <cstring>
+
+#include "streamprotocol/StreamProtocol.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define STREAMPROTOCOL_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define STREAMPROTOCOL_CRC32C_ARMV8 1
+#include <arm_acle.h>
+#endif
+
+namespace streamprotocol {
+
+namespace {
+
+using SliceTables = std::array<std::array<uint32_t, 256>, 8>;
+
+/// slice-by-8 표: [0] 은 바이트 단위 표, [k] 는 그 바이트 뒤에 0 바이트 k 개가 더 지나간 결과입니다.
+constexpr SliceTables makeSliceTables(uint32_t polynomial) {
+    SliceTables tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int j = 0; j < 8; ++j) {
+            uint32_t mask = 0 - (crc & 1);
+            crc = (crc >> 1) ^ (polynomial & mask);
+        }
+        tables[0][i] = crc;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t previous = tables[k - 1][i];
+            tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+        }
+    }
+    return tables;
+}
+
+constexpr SliceTables CRC_TABLES = makeSliceTables(0xEDB88320u);
+constexpr SliceTables CRC32C_TABLES = makeSliceTables(0x82F63B78u);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define STREAMPROTOCOL_CRC_SLICE8 1
+
+inline uint32_t foldWord(const SliceTables& t, uint32_t crc, uint64_t word) {
+    uint32_t low = static_cast<uint32_t>(word) ^ crc;
+    uint32_t high = static_cast<uint32_t>(word >> 32);
+    return t[7][low & 0xFFu] ^ t[6][(low >> 8) & 0xFFu] ^ t[5][(low >> 16) & 0xFFu] ^ t[4][low >> 24] ^
+           t[3][high & 0xFFu] ^ t[2][(high >> 8) & 0xFFu] ^ t[1][(high >> 16) & 0xFFu] ^ t[0][high >> 24];
+}
+#endif
+
+/// 표 기반 CRC 커널입니다. Copy 이면 읽은 16바이트를 레지스터에서 바로 dst 에 써서,
+/// 복사와 CRC 가 원본을 한 번만 읽도록 합니다.
+template <bool Copy>
+uint32_t updateTable(const SliceTables& t, uint32_t crc, uint8_t* dst, const uint8_t* src, size_t length) {
+#if defined(STREAMPROTOCOL_CRC_SLICE8)
+    while (length >= 16) {
+        uint64_t first;
+        uint64_t second;
+        std::memcpy(&first, src, sizeof(first));
+        std::memcpy(&second, src + 8, sizeof(second));
+        if (Copy) {
+            std::memcpy(dst, &first, sizeof(first));
+            std::memcpy(dst + 8, &second, sizeof(second));
+            dst += 16;
+        }
+        crc = foldWord(t, crc, first);
+        crc = foldWord(t, crc, second);
+        src += 16;
+        length -= 16;
+    }
+#endif
+    while (length-- > 0) {
+        uint8_t byte = *src++;
+        if (Copy) {
+            *dst++ = byte;
+        }
+        crc = (crc >> 8) ^ t[0][(crc ^ byte) & 0xFFu];
+    }
+    return crc;
+}
+
+#if defined(STREAMPROTOCOL_CRC32C_SSE42)
+template <bool Copy>
+__attribute__((target("sse4.2")))
+uint32_t updateCastagnoliHardware(uint32_t crc, uint8_t* dst, const uint8_t* src, size_t length) {
+    uint64_t crc64 = crc;
+    while (length >= 32) {
+        uint64_t words[4];
+        std::memcpy(words, src, sizeof(words));
+        if (Copy) {
+            std::memcpy(dst, words, sizeof(words));
+            dst += sizeof(words);
+        }
+        crc64 = _mm_crc32_u64(crc64, words[0]);
+        crc64 = _mm_crc32_u64(crc64, words[1]);
+        crc64 = _mm_crc32_u64(crc64, words[2]);
+        crc64 = _mm_crc32_u64(crc64, words[3]);
+        src += sizeof(words);
+        length -= sizeof(words);
+    }
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, src, sizeof(word));
+        if (Copy) {
+            std::memcpy(dst, &word, sizeof(word));
+            dst += sizeof(word);
+        }
+        crc64 = _mm_crc32_u64(crc64, word);
+        src += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+    while (length-- > 0) {
+        uint8_t byte = *src++;
+        if (Copy) {
+            *dst++ = byte;
+        }
+        crc = _mm_crc32_u8(crc, byte);
+    }
+    return crc;
+}
+
+bool cpuHasCastagnoli() {
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#elif defined(STREAMPROTOCOL_CRC32C_ARMV8)
+template <bool Copy>
+uint32_t updateCastagnoliHardware(uint32_t crc, uint8_t* dst, const uint8_t* src, size_t length) {
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, src, sizeof(word));
+        if (Copy) {
+            std::memcpy(dst, &word, sizeof(word));
+            dst += sizeof(word);
+        }
+        crc = __crc32cd(crc, word);
+        src += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        uint8_t byte = *src++;
+        if (Copy) {
+            *dst++ = byte;
+        }
+        crc = __crc32cb(crc, byte);
+    }
+    return crc;
+}
+
+bool cpuHasCastagnoli() {
+    return true;
+}
+#endif
+
+} // namespace
+
+template <bool Copy>
+uint32_t Crc32::run(uint32_t crc, Algorithm algorithm, uint8_t* dst, const uint8_t* src, size_t length) {
+    if (algorithm == Algorithm::Ieee) {
+        return updateTable<Copy>(CRC_TABLES, crc, dst, src, length);
+    }
+#if defined(STREAMPROTOCOL_CRC32C_SSE42) || defined(STREAMPROTOCOL_CRC32C_ARMV8)
+    if (cpuHasCastagnoli()) {
+        return updateCastagnoliHardware<Copy>(crc, dst, src, length);
+    }
+#endif
+    return updateTable<Copy>(CRC32C_TABLES, crc, dst, src, length);
+}
+
+void Crc32::update(const uint8_t* data, size_t length) {
+    state = run<false>(state, algorithm, nullptr, data, length);
+}
+
+void Crc32::copyUpdate(uint8_t* dst, const uint8_t* src, size_t length) {
+    state = run<true>(state, algorithm, dst, src, length);
+}
+
+uint32_t Crc32::compute(const uint8_t* data, size_t length, Algorithm algorithm) {
+    Crc32 crc(algorithm);
+    crc.update(data, length);
+    return crc.value();
+}
+
+Crc32::Algorithm Crc32::ForVersion(uint8_t protocolVersion) {
+    return protocolVersion == StreamProtocol::CRC32C_PROTOCOL_VERSION ? Algorithm::Castagnoli : Algorithm::Ieee;
+}
+
+bool Crc32::HardwareCastagnoli() {
+#if defined(STREAMPROTOCOL_CRC32C_SSE42) || defined(STREAMPROTOCOL_CRC32C_ARMV8)
+    return cpuHasCastagnoli();
+#else
+    return false;
+#endif
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,270 @@
+#include "streamprotocol/DeltaCodec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "streamprotocol/FrameBuffer.hpp"
+#include "streamprotocol/PacketException.h"
+
+#include "Detail.hpp"
+
+namespace streamprotocol {
+
+namespace {
+
+// 이보다 짧은 0 구간은 건너뛰기(길이 2개)보다 리터럴에 넣는 편이 작습니다.
+constexpr size_t MIN_SKIP = 4;
+
+uint64_t load64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/// pos 부터 새 페이로드가 직전 페이로드(common 뒤로는 0)와 같은 구간의 끝을 찾습니다.
+size_t matchEnd(const uint8_t* data, const uint8_t* previous, size_t common, size_t size, size_t pos) {
+    while (pos + 8 <= common && load64(data + pos) == load64(previous + pos)) {
+        pos += 8;
+    }
+    while (pos < common && data[pos] == previous[pos]) {
+        ++pos;
+    }
+    if (pos < common) {
+        return pos;
+    }
+    while (pos + 8 <= size && load64(data + pos) == 0) {
+        pos += 8;
+    }
+    while (pos < size && data[pos] == 0) {
+        ++pos;
+    }
+    return pos;
+}
+
+void checkChannel(uint16_t channel) {
+    if (channel >= DeltaEncoder::CHANNELS) {
+        throw std::invalid_argument("channel must be 10-bit (0-1023)");
+    }
+}
+
+} // namespace
+
+DeltaEncoder::DeltaEncoder(StreamProtocol& protocol)
+    : DeltaEncoder(protocol, Options()) {
+}
+
+DeltaEncoder::DeltaEncoder(StreamProtocol& protocol, const Options& options)
+    : protocol(protocol), options(options), channels(CHANNELS) {
+}
+
+size_t DeltaEncoder::writeDelta(const Channel& channel, const uint8_t* data, size_t size, uint8_t* out,
+                                size_t capacity) const {
+    const uint8_t* previous = channel.previous.data();
+    size_t common = std::min(size, channel.previous.size());
+    auto same = [&](size_t i) { return i < common ? data[i] == previous[i] : data[i] == 0; };
+
+    if (detail::varintSize(size) > capacity) {
+        return 0;
+    }
+    size_t used = detail::writeVarint(out, size);
+    size_t pos = 0;
+    while (pos < size) {
+        size_t runStart = pos;
+        pos = matchEnd(data, previous, common, size, pos);
+        if (pos == size) {
+            break;
+        }
+        size_t skip = pos - runStart;
+
+        // 리터럴은 MIN_SKIP 이상의 0 구간이나 끝을 만날 때까지 늘립니다.
+        size_t literal = pos;
+        for (;;) {
+            while (pos < size && !same(pos)) {
+                ++pos;
+            }
+            if (pos == size) {
+                break;
+            }
+            size_t gapEnd = matchEnd(data, previous, common, size, pos);
+            if (gapEnd - pos >= MIN_SKIP || gapEnd == size) {
+                break;
+            }
+            pos = gapEnd;
+        }
+        size_t length = pos - literal;
+
+        if (detail::varintSize(skip) + detail::varintSize(length) + length > capacity - used) {
+            return 0;
+        }
+        used += detail::writeVarint(out + used, skip);
+        used += detail::writeVarint(out + used, length);
+        size_t split = std::max(literal, std::min(pos, common));
+        for (size_t i = literal; i < split; ++i) {
+            out[used++] = static_cast<uint8_t>(data[i] ^ previous[i]);
+        }
+        std::memcpy(out + used, data + split, pos - split);
+        used += pos - split;
+    }
+    return used;
+}
+
+std::vector<uint8_t> DeltaEncoder::encode(const uint8_t* data, size_t size, uint8_t payloadType, uint16_t channel) {
+    if (data == nullptr && size != 0) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    if (payloadType > 0x0F || payloadType == PayloadType::DELTA) {
+        throw std::invalid_argument("payloadType must be 0-15 and not DELTA");
+    }
+    checkChannel(channel);
+    if (size >= StreamProtocol::MAX_PAYLOAD_LENGTH) {
+        throw PayloadTooLargeException(size + 1, StreamProtocol::MAX_PAYLOAD_LENGTH);
+    }
+
+    Channel& state = channels[channel];
+    bool keyframe = !state.valid || (options.keyframeInterval != 0 && state.sinceKeyframe >= options.keyframeInterval);
+
+    FrameBuffer buffer(1 + size);
+    buffer.resize(1 + size);
+    uint8_t* out = buffer.Payload();
+    if (!keyframe) {
+        // 차분이 원본(size 바이트)보다 작을 때만 차분으로 보냅니다.
+        size_t used = writeDelta(state, data, size, out + 1, size);
+        if (used == 0) {
+            keyframe = true;
+            stats.fallbackKeyframes++;
+        } else {
+            out[0] = payloadType;
+            buffer.resize(1 + used);
+            state.sinceKeyframe++;
+            stats.deltas++;
+        }
+    }
+    if (keyframe) {
+        out[0] = static_cast<uint8_t>(payloadType | KEYFRAME_FLAG);
+        if (size != 0) {
+            std::memcpy(out + 1, data, size);
+        }
+        state.sinceKeyframe = 1;
+        stats.keyframes++;
+    }
+    state.previous.assign(data, data + size);
+    state.valid = true;
+
+    stats.inputBytes += size;
+    stats.outputBytes += buffer.PayloadSize();
+    return protocol.toBytes(std::move(buffer), PayloadType::DELTA, StreamProtocol::UNFRAGED, channel);
+}
+
+void DeltaEncoder::forceKeyframe(uint16_t channel) {
+    checkChannel(channel);
+    channels[channel].valid = false;
+}
+
+void DeltaEncoder::forceKeyframeAll() {
+    for (Channel& channel : channels) {
+        channel.valid = false;
+    }
+}
+
+DeltaDecoder::DeltaDecoder()
+    : DeltaDecoder(Options()) {
+}
+
+DeltaDecoder::DeltaDecoder(const Options& options)
+    : options(options), channels(DeltaEncoder::CHANNELS) {
+}
+
+bool DeltaDecoder::decode(const ParsedPacketView& frame, DeltaPayload& out) {
+    if (frame.PayloadType() != PayloadType::DELTA) {
+        return false;
+    }
+    out = decode(frame.Payload(), frame.PayloadSize(), frame.UserField());
+    return true;
+}
+
+DeltaPayload DeltaDecoder::decode(const uint8_t* payload, size_t size, uint16_t channel) {
+    checkChannel(channel);
+    if (payload == nullptr || size == 0) {
+        throw PacketException("Empty delta payload");
+    }
+    uint8_t flags = payload[0];
+    if ((flags & 0xE0u) != 0 || (flags & 0x0Fu) == PayloadType::DELTA) {
+        throw PacketException("Invalid delta flags: " + std::to_string(flags));
+    }
+
+    Channel& state = channels[channel];
+    bool keyframe = (flags & DeltaEncoder::KEYFRAME_FLAG) != 0;
+    if (keyframe) {
+        if (size - 1 > options.maxPayloadSize) {
+            throw PayloadTooLargeException(size - 1, options.maxPayloadSize);
+        }
+        state.current.assign(payload + 1, payload + size);
+        state.valid = true;
+    } else {
+        if (!state.valid) {
+            throw PacketException("Delta frame before keyframe on channel " + std::to_string(channel));
+        }
+        try {
+            applyDelta(state, payload + 1, size - 1);
+        } catch (...) {
+            // 버퍼가 일부만 바뀌었을 수 있으므로 다음 키프레임까지 채널을 막습니다.
+            state.valid = false;
+            state.current.clear();
+            throw;
+        }
+    }
+
+    DeltaPayload result;
+    result.payloadType = static_cast<uint8_t>(flags & 0x0Fu);
+    result.channel = channel;
+    result.keyframe = keyframe;
+    result.data = state.current.data();
+    result.size = state.current.size();
+    return result;
+}
+
+void DeltaDecoder::applyDelta(Channel& channel, const uint8_t* delta, size_t size) {
+    size_t pos = 0;
+    uint64_t newSize = detail::readVarint(delta, size, pos, "Malformed delta varint");
+    if (newSize > options.maxPayloadSize) {
+        throw PayloadTooLargeException(static_cast<size_t>(newSize), options.maxPayloadSize);
+    }
+    // 줄어들면 뒤를 버리고, 늘어나면 0 으로 채웁니다. (인코더가 직전 페이로드 뒤를 0 으로 보는 것과 같음)
+    channel.current.resize(static_cast<size_t>(newSize));
+    uint8_t* out = channel.current.data();
+
+    size_t offset = 0;
+    while (pos < size) {
+        uint64_t skip = detail::readVarint(delta, size, pos, "Malformed delta varint");
+        uint64_t length = detail::readVarint(delta, size, pos, "Malformed delta varint");
+        if (skip > newSize - offset || length > newSize - offset - skip || length > size - pos) {
+            throw PacketException("Delta run exceeds payload: offset " + std::to_string(offset) + ", skip " +
+                                  std::to_string(skip) + ", length " + std::to_string(length) + " (size " +
+                                  std::to_string(newSize) + ")");
+        }
+        offset += static_cast<size_t>(skip);
+        const uint8_t* literal = delta + pos;
+        for (size_t i = 0; i < length; ++i) {
+            out[offset + i] ^= literal[i];
+        }
+        offset += static_cast<size_t>(length);
+        pos += static_cast<size_t>(length);
+    }
+}
+
+void DeltaDecoder::reset(uint16_t channel) {
+    checkChannel(channel);
+    channels[channel].valid = false;
+    channels[channel].current.clear();
+}
+
+void DeltaDecoder::resetAll() {
+    for (Channel& channel : channels) {
+        channel.valid = false;
+        channel.current.clear();
+    }
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,94 @@
+#pragma once
+
+// 여러 구현 파일이 함께 쓰는 내부 도우미입니다. 공개 헤더가 아니므로 src/ 안에서만 포함합니다.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "streamprotocol/PacketException.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+namespace streamprotocol {
+namespace detail {
+
+inline void putLE64(uint8_t* out, uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+inline uint64_t getLE64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (i * 8);
+    }
+    return value;
+}
+
+/// LEB128 부호 없는 varint 의 최대 길이 (uint64_t).
+constexpr size_t MAX_VARINT_SIZE = 10;
+
+inline size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+inline size_t writeVarint(uint8_t* out, uint64_t value) {
+    size_t i = 0;
+    while (value >= 0x80) {
+        out[i++] = static_cast<uint8_t>(value | 0x80u);
+        value >>= 7;
+    }
+    out[i++] = static_cast<uint8_t>(value);
+    return i;
+}
+
+/// data[pos] 부터 varint 하나를 읽고 pos 를 넘깁니다. 잘렸거나 MAX_VARINT_SIZE 를 넘으면 malformed 를 메시지로 PacketException.
+inline uint64_t readVarint(const uint8_t* data, size_t size, size_t& pos, const char* malformed) {
+    uint64_t value = 0;
+    for (size_t i = 0;; ++i) {
+        if (pos >= size || i == MAX_VARINT_SIZE) {
+            throw PacketException(malformed);
+        }
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7Fu) << (7 * i);
+        if ((byte & 0x80u) == 0) {
+            return value;
+        }
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/// 디렉터리에 이름 없는 임시 파일을 만듭니다. (Linux 는 O_TMPFILE, 그 밖에는 <prefix>-XXXXXX 로 mkstemp 후 unlink)
+inline int openSpillFile(const std::string& directory, const char* prefix) {
+#if defined(O_TMPFILE)
+    int fd = ::open(directory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+    if (fd >= 0) {
+        return fd;
+    }
+#endif
+    std::string path = directory + "/" + prefix + "-XXXXXX";
+    int fd2 = ::mkstemp(&path[0]);
+    if (fd2 < 0) {
+        throw std::system_error(errno, std::generic_category(), "mkstemp");
+    }
+    ::unlink(path.c_str());
+    return fd2;
+}
+#endif
+
+} // namespace detail
+} // namespace streamprotocol
@@ -0,0 +1,124 @@
+#include "streamprotocol/EncodedFrameCache.hpp"
+
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+
+namespace streamprotocol {
+
+namespace {
+
+size_t frameHash(const uint8_t* header, const uint8_t* data, size_t size) {
+    size_t hash = std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(data), size));
+    uint64_t headerValue;
+    std::memcpy(&headerValue, header, sizeof(headerValue));
+    return hash ^ (std::hash<uint64_t>()(headerValue) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2));
+}
+
+bool sameFrame(const std::vector<uint8_t>& frame, const uint8_t* header, const uint8_t* data, size_t size) {
+    return frame.size() == size + StreamProtocol::FRAME_OVERHEAD &&
+           std::memcmp(frame.data(), header, StreamProtocol::HEADER_SIZE) == 0 &&
+           (size == 0 || std::memcmp(frame.data() + StreamProtocol::HEADER_SIZE, data, size) == 0);
+}
+
+} // namespace
+
+EncodedFrameCache::EncodedFrameCache(const StreamProtocol& protocol)
+    : EncodedFrameCache(protocol, Options()) {
+}
+
+EncodedFrameCache::EncodedFrameCache(const StreamProtocol& protocol, const Options& options)
+    : protocol(protocol), options(options) {
+    if (options.maxEntries == 0) {
+        throw std::invalid_argument("maxEntries must be at least 1");
+    }
+}
+
+void EncodedFrameCache::evictFor(size_t incoming) {
+    while (!entries.empty() && (entries.size() >= options.maxEntries || bytes + incoming > options.maxBytes)) {
+        Entry& victim = entries.back();
+        auto range = index.equal_range(victim.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (&*it->second == &victim) {
+                index.erase(it);
+                break;
+            }
+        }
+        bytes -= victim.frame->size();
+        entries.pop_back();
+        ++stats.evictions;
+    }
+}
+
+EncodedFrameCache::Frame EncodedFrameCache::get(const uint8_t* data, size_t size, uint8_t payloadType,
+                                                uint8_t fragFlag, uint16_t userValue) {
+    if (data == nullptr && size != 0) {
+        throw std::invalid_argument("data must not be null");
+    }
+    // 헤더에는 프로토콜 버전과 길이까지 들어 있으므로, 헤더 + 페이로드가 같으면 같은 프레임입니다.
+    uint8_t header[StreamProtocol::HEADER_SIZE];
+    protocol.encodeHeader(header, size, payloadType, fragFlag, userValue);
+    size_t hash = frameHash(header, data, size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto range = index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (sameFrame(*it->second->frame, header, data, size)) {
+                entries.splice(entries.begin(), entries, it->second);
+                ++stats.hits;
+                return it->second->frame;
+            }
+        }
+        ++stats.misses;
+    }
+
+    // 인코딩(복사 + CRC)은 잠금 밖에서 합니다.
+    auto encoded = std::make_shared<std::vector<uint8_t>>(size + StreamProtocol::FRAME_OVERHEAD);
+    protocol.encodeInto(data, size, encoded->data(), encoded->size(), payloadType, fragFlag, userValue);
+    Frame frame = std::move(encoded);
+    if (frame->size() > options.maxBytes) {
+        return frame;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // 그 사이 다른 스레드가 같은 프레임을 넣었으면 그쪽을 씁니다.
+    auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (sameFrame(*it->second->frame, header, data, size)) {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->frame;
+        }
+    }
+    evictFor(frame->size());
+    entries.push_front(Entry{ hash, frame });
+    index.emplace(hash, entries.begin());
+    bytes += frame->size();
+    return frame;
+}
+
+void EncodedFrameCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    bytes = 0;
+}
+
+size_t EncodedFrameCache::Entries() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+size_t EncodedFrameCache::Bytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
+
+EncodedFrameCache::Stats EncodedFrameCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,157 @@
+#include "streamprotocol/FileFrame.hpp"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace streamprotocol {
+
+namespace {
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// 소켓이 아닌 fd(파이프, 파일 등)는 첫 ENOTSOCK 에서 write() 로 바꾸고, 그 결과를 isSocket 에 남겨
+// 같은 프레임의 이후 호출은 send() 를 다시 시도하지 않습니다.
+// 소켓이면 MSG_MORE 로 보내 헤더가 페이로드와 같은 세그먼트에 실리도록 합니다.
+void writeAll(int fd, bool& isSocket, const uint8_t* data, size_t size, bool more) {
+    while (size > 0) {
+        ssize_t written = isSocket ? ::send(fd, data, size, MSG_NOSIGNAL | (more ? MSG_MORE : 0))
+                                   : ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (isSocket && errno == ENOTSOCK) {
+                isSocket = false;
+                continue;
+            }
+            throwErrno("write");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void copyWithPread(int outFd, bool& isSocket, int fileFd, uint64_t offset, uint64_t length) {
+    std::vector<uint8_t> buffer(static_cast<size_t>(std::min<uint64_t>(length, 64u * 1024u)));
+    while (length > 0) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(length, buffer.size()));
+        ssize_t got = ::pread(fileFd, buffer.data(), want, static_cast<off_t>(offset));
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("pread");
+        }
+        if (got == 0) {
+            throw std::system_error(EIO, std::generic_category(), "file region shrank while sending");
+        }
+        writeAll(outFd, isSocket, buffer.data(), static_cast<size_t>(got), true);
+        offset += static_cast<uint64_t>(got);
+        length -= static_cast<uint64_t>(got);
+    }
+}
+
+} // namespace
+
+FileFrameSender::FileFrameSender(const StreamProtocol& protocol, size_t mapWindow, bool useSendfile)
+    : protocol(protocol), mapWindow(mapWindow), useSendfile(useSendfile) {
+    long pageSize = ::sysconf(_SC_PAGESIZE);
+    if (mapWindow == 0 || pageSize <= 0 || mapWindow % static_cast<size_t>(pageSize) != 0) {
+        throw std::invalid_argument("mapWindow must be a non-zero multiple of the page size");
+    }
+}
+
+void FileFrameSender::updateCrc(Crc32& crc, int fileFd, uint64_t offset, uint64_t length) const {
+    uint64_t pageSize = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    while (length > 0) {
+        // mmap 오프셋은 페이지 경계여야 하므로 앞쪽 여백(lead)을 두고 매핑합니다.
+        uint64_t lead = offset % pageSize;
+        size_t span = static_cast<size_t>(std::min<uint64_t>(length, mapWindow - lead));
+        void* mapping = ::mmap(nullptr, lead + span, PROT_READ, MAP_SHARED, fileFd, static_cast<off_t>(offset - lead));
+        if (mapping == MAP_FAILED) {
+            throwErrno("mmap");
+        }
+        ::madvise(mapping, lead + span, MADV_SEQUENTIAL);
+        crc.update(static_cast<const uint8_t*>(mapping) + lead, span);
+        ::munmap(mapping, lead + span);
+
+        offset += span;
+        length -= span;
+    }
+}
+
+uint64_t FileFrameSender::send(int outFd, int fileFd, uint64_t offset, uint64_t length, uint8_t payloadType,
+                               uint8_t fragFlag, uint16_t userValue) const {
+    if (length > StreamProtocol::MAX_PAYLOAD_LENGTH) {
+        throw PayloadTooLargeException(length, StreamProtocol::MAX_PAYLOAD_LENGTH);
+    }
+
+    // 영역이 파일 안에 있는지 먼저 확인합니다. (mmap 범위 밖 접근은 SIGBUS)
+    struct stat st;
+    if (::fstat(fileFd, &st) != 0) {
+        throwErrno("fstat");
+    }
+    if (offset > static_cast<uint64_t>(st.st_size) || length > static_cast<uint64_t>(st.st_size) - offset) {
+        throw std::invalid_argument("file region is out of range");
+    }
+
+    uint8_t header[StreamProtocol::HEADER_SIZE];
+    protocol.encodeHeader(header, static_cast<size_t>(length), payloadType, fragFlag, userValue);
+
+    Crc32 crc(Crc32::ForVersion(protocol.ProtocolVersion()));
+    crc.update(header, sizeof(header));
+    updateCrc(crc, fileFd, offset, length);
+    uint32_t value = crc.value();
+    uint8_t trailer[sizeof(uint32_t)];
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        trailer[i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFFu);
+    }
+
+    bool isSocket = true;
+    writeAll(outFd, isSocket, header, sizeof(header), length > 0);
+
+    off_t position = static_cast<off_t>(offset);
+    uint64_t remaining = length;
+    if (!useSendfile && length > 0) {
+        copyWithPread(outFd, isSocket, fileFd, offset, length);
+        remaining = 0;
+    }
+    while (remaining > 0) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(remaining, 0x7FFFF000u));   // sendfile 1회 최대 전송량
+        ssize_t sent = ::sendfile(outFd, fileFd, &position, want);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EINVAL || errno == ENOSYS) && remaining == length) {
+                copyWithPread(outFd, isSocket, fileFd, offset, length);
+                break;
+            }
+            throwErrno("sendfile");
+        }
+        if (sent == 0) {
+            throw std::system_error(EIO, std::generic_category(), "file region shrank while sending");
+        }
+        remaining -= static_cast<uint64_t>(sent);
+    }
+
+    writeAll(outFd, isSocket, trailer, sizeof(trailer), false);
+    return StreamProtocol::FRAME_OVERHEAD + length;
+}
+
+} // namespace streamprotocol
+
+#endif // __linux__
@@ -0,0 +1,91 @@
+#include "streamprotocol/FrameReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace streamprotocol {
+
+FrameReader::FrameReader(const StreamProtocol& protocol, Callbacks callbacks, size_t maxChunkSize)
+    : protocol(protocol), callbacks(std::move(callbacks)), maxChunkSize(maxChunkSize) {
+    if (!this->callbacks.onPayload || !this->callbacks.onEnd) {
+        throw std::invalid_argument("FrameReader requires onPayload and onEnd callbacks");
+    }
+    if (maxChunkSize == 0) {
+        throw std::invalid_argument("maxChunkSize must be non-zero");
+    }
+}
+
+void FrameReader::startFrame() {
+    scratchSize = 0;
+    header = protocol.decodeHeader(scratch);
+    if (header.packetLength > maxPacketLength) {
+        throw PayloadTooLargeException(header.packetLength, maxPacketLength);
+    }
+
+    crc = Crc32(Crc32::ForVersion(header.protocolVersion));
+    crc.update(scratch, StreamProtocol::HEADER_SIZE);
+    payloadRemaining = header.PayloadSize();
+    state = payloadRemaining == 0 ? State::Trailer : State::Payload;
+
+    if (callbacks.onHeader) {
+        callbacks.onHeader(header);
+    }
+}
+
+void FrameReader::endFrame() {
+    uint32_t receivedCRC = 0;
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        receivedCRC |= static_cast<uint32_t>(scratch[i]) << (i * 8);
+    }
+    scratchSize = 0;
+    state = State::Header;
+    callbacks.onEnd(header, receivedCRC == crc.value());
+}
+
+void FrameReader::feed(const uint8_t* data, size_t size) {
+    if (data == nullptr && size != 0) {
+        throw std::invalid_argument("data must not be null");
+    }
+
+    while (size > 0) {
+        switch (state) {
+            case State::Header: {
+                size_t take = std::min(size, StreamProtocol::HEADER_SIZE - scratchSize);
+                std::memcpy(scratch + scratchSize, data, take);
+                scratchSize += take;
+                data += take;
+                size -= take;
+                if (scratchSize == StreamProtocol::HEADER_SIZE) {
+                    startFrame();
+                }
+                break;
+            }
+            case State::Payload: {
+                size_t take = static_cast<size_t>(std::min<uint64_t>(std::min(size, maxChunkSize), payloadRemaining));
+                crc.update(data, take);
+                payloadRemaining -= take;
+                if (payloadRemaining == 0) {
+                    state = State::Trailer;
+                }
+                callbacks.onPayload(header, data, take);
+                data += take;
+                size -= take;
+                break;
+            }
+            case State::Trailer: {
+                size_t take = std::min(size, sizeof(uint32_t) - scratchSize);
+                std::memcpy(scratch + scratchSize, data, take);
+                scratchSize += take;
+                data += take;
+                size -= take;
+                if (scratchSize == sizeof(uint32_t)) {
+                    endFrame();
+                }
+                break;
+            }
+        }
+    }
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,247 @@
+#include "streamprotocol/FrameRing.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr uint64_t RECORD_WORD_SIZE = sizeof(uint64_t);
+constexpr uint64_t RECORD_ALIGNMENT = 8;
+
+// 레코드 워드: (길이 << 1) | 1 = 프레임, (길이 << 1) | 0 = 건너뛸 패딩 영역
+constexpr uint64_t WORD_FRAME_BIT = 1;
+
+inline uint64_t alignRecord(uint64_t size) {
+    return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+inline uint64_t recordSpan(size_t frameSize) {
+    return alignRecord(RECORD_WORD_SIZE + frameSize);
+}
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "record word must be a plain 64-bit slot");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "FrameRing requires lock-free 64-bit atomics");
+
+} // namespace
+
+template <bool MultiProducer>
+BasicFrameRing<MultiProducer>::BasicFrameRing(size_t capacity, const StreamProtocol& protocol)
+    : ownedControl(new FrameRingControl()),
+      control(nullptr), data(nullptr), capacity(capacity), mask(capacity - 1), protocol(protocol) {
+    if (capacity < 64 || (capacity & (capacity - 1)) != 0) {
+        throw std::invalid_argument("FrameRing capacity must be a power of two (>= 64)");
+    }
+    ownedData.reset(new (std::align_val_t(CACHE_LINE_SIZE)) uint8_t[capacity]());
+    control = ownedControl.get();
+    data = ownedData.get();
+}
+
+template <bool MultiProducer>
+BasicFrameRing<MultiProducer>::BasicFrameRing(FrameRingControl* control, uint8_t* data, size_t capacity, const StreamProtocol& protocol)
+    : control(control), data(data), capacity(capacity), mask(capacity - 1), protocol(protocol) {
+    if (control == nullptr || data == nullptr) {
+        throw std::invalid_argument("FrameRing control/data must not be null");
+    }
+    if (capacity < 64 || (capacity & (capacity - 1)) != 0) {
+        throw std::invalid_argument("FrameRing capacity must be a power of two (>= 64)");
+    }
+    if (reinterpret_cast<uintptr_t>(data) % RECORD_ALIGNMENT != 0) {
+        throw std::invalid_argument("FrameRing data must be 8-byte aligned");
+    }
+    cachedTail = control->tail.load(std::memory_order_acquire);
+}
+
+template <bool MultiProducer>
+std::atomic<uint64_t>& BasicFrameRing<MultiProducer>::wordAt(uint64_t position) const {
+    return *reinterpret_cast<std::atomic<uint64_t>*>(data + (position & mask));
+}
+
+template <bool MultiProducer>
+uint8_t* BasicFrameRing<MultiProducer>::reserveRecord(size_t frameSize) {
+    const uint64_t span = recordSpan(frameSize);
+
+    if (!MultiProducer) {
+        uint64_t head = control->head.load(std::memory_order_relaxed);
+        uint64_t offset = head & mask;
+        uint64_t pad = (offset + span > capacity) ? capacity - offset : 0;
+        uint64_t required = pad + span;
+
+        if (head + required - cachedTail > capacity) {
+            cachedTail = control->tail.load(std::memory_order_acquire);
+            if (head + required - cachedTail > capacity) {
+                return nullptr;
+            }
+        }
+
+        if (pad != 0) {
+            wordAt(head).store(pad << 1, std::memory_order_release);
+        }
+        control->head.store(head + required, std::memory_order_relaxed);
+        return data + ((head + pad) & mask);
+    }
+
+    uint64_t head = control->head.load(std::memory_order_relaxed);
+    while (true) {
+        uint64_t tail = control->tail.load(std::memory_order_acquire);
+        uint64_t offset = head & mask;
+        uint64_t pad = (offset + span > capacity) ? capacity - offset : 0;
+        uint64_t required = pad + span;
+
+        if (head + required - tail > capacity) {
+            return nullptr;
+        }
+        if (control->head.compare_exchange_weak(head, head + required,
+                                                std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            if (pad != 0) {
+                wordAt(head).store(pad << 1, std::memory_order_release);
+            }
+            return data + ((head + pad) & mask);
+        }
+    }
+}
+
+template <bool MultiProducer>
+void BasicFrameRing<MultiProducer>::publish(const FrameSlot& slot, uint64_t word) {
+    reinterpret_cast<std::atomic<uint64_t>*>(slot.record)->store(word, std::memory_order_release);
+}
+
+template <bool MultiProducer>
+FrameSlot BasicFrameRing<MultiProducer>::tryReserve(size_t payloadSize) {
+    FrameSlot slot;
+    if (payloadSize > MaxPayloadSize()) {
+        throw PayloadTooLargeException(payloadSize, MaxPayloadSize());
+    }
+    size_t frameSize = payloadSize + StreamProtocol::FRAME_OVERHEAD;
+    slot.record = reserveRecord(frameSize);
+    if (slot.record != nullptr) {
+        slot.frameSize = frameSize;
+    }
+    return slot;
+}
+
+template <bool MultiProducer>
+void BasicFrameRing<MultiProducer>::commit(FrameSlot& slot, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) {
+    if (!slot) {
+        throw std::invalid_argument("commit on empty FrameSlot");
+    }
+    try {
+        protocol.sealFrame(slot.Frame(), slot.PayloadSize(), payloadType, fragFlag, userValue);
+    } catch (...) {
+        cancel(slot);
+        throw;
+    }
+    commitFrame(slot);
+}
+
+template <bool MultiProducer>
+void BasicFrameRing<MultiProducer>::commitFrame(FrameSlot& slot) {
+    if (!slot) {
+        throw std::invalid_argument("commit on empty FrameSlot");
+    }
+    publish(slot, (static_cast<uint64_t>(slot.frameSize) << 1) | WORD_FRAME_BIT);
+    slot.record = nullptr;
+}
+
+template <bool MultiProducer>
+void BasicFrameRing<MultiProducer>::cancel(FrameSlot& slot) {
+    if (!slot) {
+        return;
+    }
+    publish(slot, recordSpan(slot.frameSize) << 1);
+    slot.record = nullptr;
+}
+
+template <bool MultiProducer>
+bool BasicFrameRing<MultiProducer>::tryWrite(const uint8_t* payload, size_t size, uint8_t payloadType,
+                                             uint8_t fragFlag, uint16_t userValue) {
+    if (payload == nullptr && size != 0) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    FrameSlot slot = tryReserve(size);
+    if (!slot) {
+        return false;
+    }
+    if (size != 0) {
+        std::memcpy(slot.Payload(), payload, size);
+    }
+    commit(slot, payloadType, fragFlag, userValue);
+    return true;
+}
+
+template <bool MultiProducer>
+bool BasicFrameRing<MultiProducer>::tryWriteFrame(const uint8_t* frame, size_t size) {
+    if (frame == nullptr || size < StreamProtocol::FRAME_OVERHEAD) {
+        throw BufferTooSmallException(frame == nullptr ? 0 : size);
+    }
+    FrameSlot slot = tryReserve(size - StreamProtocol::FRAME_OVERHEAD);
+    if (!slot) {
+        return false;
+    }
+    std::memcpy(slot.Frame(), frame, size);
+    commitFrame(slot);
+    return true;
+}
+
+template <bool MultiProducer>
+bool BasicFrameRing<MultiProducer>::tryPeekFrame(const uint8_t*& frame, size_t& size) {
+    if (pendingSpan != 0) {
+        throw std::logic_error("FrameRing: previous record was not released");
+    }
+    while (true) {
+        uint64_t tail = control->tail.load(std::memory_order_relaxed);
+        uint64_t word = wordAt(tail).load(std::memory_order_acquire);
+        if (word == 0) {
+            return false;
+        }
+
+        // 링이 공유 메모리 위에 있으면 상대 프로세스가 쓴 레코드 워드를 그대로 믿을 수 없습니다.
+        uint64_t offset = tail & mask;
+        if ((word & WORD_FRAME_BIT) == 0) {
+            // 패딩 또는 취소된 레코드: 0 으로 되돌리고 건너뜁니다.
+            uint64_t span = word >> 1;
+            if (span % RECORD_ALIGNMENT != 0 || offset + span > capacity) {
+                throw PacketException("Corrupted FrameRing record");
+            }
+            std::memset(data + offset, 0, static_cast<size_t>(span));
+            control->tail.store(tail + span, std::memory_order_release);
+            continue;
+        }
+
+        if ((word >> 1) < StreamProtocol::FRAME_OVERHEAD || offset + recordSpan(static_cast<size_t>(word >> 1)) > capacity) {
+            throw PacketException("Corrupted FrameRing record");
+        }
+        size = static_cast<size_t>(word >> 1);
+        frame = data + offset + RECORD_WORD_SIZE;
+        pendingSpan = recordSpan(size);
+        return true;
+    }
+}
+
+template <bool MultiProducer>
+bool BasicFrameRing<MultiProducer>::tryRead(ParsedPacketView& view) {
+    const uint8_t* frame = nullptr;
+    size_t size = 0;
+    if (!tryPeekFrame(frame, size)) {
+        return false;
+    }
+    view = protocol.parsePacketView(frame, size);
+    return true;
+}
+
+template <bool MultiProducer>
+void BasicFrameRing<MultiProducer>::release() {
+    if (pendingSpan == 0) {
+        return;
+    }
+    uint64_t tail = control->tail.load(std::memory_order_relaxed);
+    std::memset(data + (tail & mask), 0, static_cast<size_t>(pendingSpan));
+    control->tail.store(tail + pendingSpan, std::memory_order_release);
+    pendingSpan = 0;
+}
+
+template class BasicFrameRing<false>;
+template class BasicFrameRing<true>;
+
+} // namespace streamprotocol
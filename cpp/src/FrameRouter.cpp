@@ -0,0 +1,256 @@
+#include "streamprotocol/FrameRouter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "streamprotocol/Crc32.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace streamprotocol {
+
+FrameRouter::FrameRouter(const StreamProtocol& protocol)
+    : FrameRouter(protocol, Options()) {
+}
+
+FrameRouter::FrameRouter(const StreamProtocol& protocol, const Options& options)
+    : protocol(protocol), options(options), userRoutes(1024, NO_ROUTE) {
+    if (options.maxPacketLength < StreamProtocol::FRAME_OVERHEAD) {
+        throw std::invalid_argument("maxPacketLength must be at least 12");
+    }
+    typeRoutes.fill(NO_ROUTE);
+#if defined(__linux__)
+    if (::pipe2(pipeFds, O_CLOEXEC) != 0) {
+        throw std::system_error(errno, std::generic_category(), "pipe2");
+    }
+#endif
+}
+
+FrameRouter::~FrameRouter() {
+#if defined(__linux__)
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+#endif
+}
+
+void FrameRouter::SetUserRoute(uint16_t userField, int target) {
+    if (userField > 0x3FF) {
+        throw std::invalid_argument("userField must be 10-bit (0-1023)");
+    }
+    userRoutes[userField] = target;
+}
+
+void FrameRouter::SetTypeRoute(uint8_t payloadType, int target) {
+    if (payloadType > 0x0F) {
+        throw std::invalid_argument("payloadType must be 4 bits (0-15)");
+    }
+    typeRoutes[payloadType] = target;
+}
+
+int FrameRouter::Lookup(const FrameHeader& header) const {
+    int target = userRoutes[header.userField];
+    if (target == NO_ROUTE) {
+        target = typeRoutes[header.payloadType];
+    }
+    return target == NO_ROUTE ? defaultRoute : target;
+}
+
+FrameHeader FrameRouter::checkedHeader(const uint8_t* header) const {
+    FrameHeader decoded = protocol.decodeHeader(header);
+    if (decoded.packetLength > options.maxPacketLength) {
+        throw PayloadTooLargeException(static_cast<size_t>(decoded.packetLength), options.maxPacketLength);
+    }
+    return decoded;
+}
+
+size_t FrameRouter::route(const uint8_t* data, size_t size, const Handler& handler) {
+    if (data == nullptr && size != 0) {
+        throw std::invalid_argument("data must not be null");
+    }
+    size_t offset = 0;
+    while (size - offset >= StreamProtocol::HEADER_SIZE) {
+        FrameHeader header = checkedHeader(data + offset);
+        size_t length = static_cast<size_t>(header.packetLength);
+        if (size - offset < length) {
+            break;
+        }
+        const uint8_t* frame = data + offset;
+        offset += length;
+
+        if (options.verifyCrc) {
+            size_t crcOffset = length - sizeof(uint32_t);
+            uint32_t received = 0;
+            for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+                received |= static_cast<uint32_t>(frame[crcOffset + i]) << (i * 8);
+            }
+            if (Crc32::compute(frame, crcOffset, Crc32::ForVersion(header.protocolVersion)) != received) {
+                ++stats.crcErrors;
+                continue;
+            }
+        }
+        int target = Lookup(header);
+        if (target == NO_ROUTE) {
+            ++stats.framesDropped;
+            continue;
+        }
+        handler(target, frame, length);
+        ++stats.framesForwarded;
+        stats.bytesForwarded += length;
+    }
+    return offset;
+}
+
+#if defined(__linux__)
+
+namespace {
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// size 바이트를 모두 읽습니다. 하나도 못 읽고 EOF 면 false.
+bool readFully(int fd, uint8_t* data, size_t size) {
+    size_t got = 0;
+    while (got < size) {
+        ssize_t n = ::read(fd, data + got, size - got);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("read");
+        }
+        if (n == 0) {
+            if (got == 0) {
+                return false;
+            }
+            throw PacketException("connection closed mid-frame");
+        }
+        got += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 소켓이면 MSG_MORE 로 보내 헤더가 뒤따르는 바이트와 같은 세그먼트에 실리도록 합니다.
+void writeAll(int fd, const uint8_t* data, size_t size, bool more) {
+    bool isSocket = true;
+    while (size > 0) {
+        ssize_t written = isSocket ? ::send(fd, data, size, MSG_NOSIGNAL | (more ? MSG_MORE : 0))
+                                   : ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (isSocket && errno == ENOTSOCK) {
+                isSocket = false;
+                continue;
+            }
+            throwErrno("write");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+constexpr size_t COPY_CHUNK = 64u * 1024u;
+
+} // namespace
+
+bool FrameRouter::forward(int inFd) {
+    uint8_t header[StreamProtocol::HEADER_SIZE];
+    if (!readFully(inFd, header, sizeof(header))) {
+        return false;
+    }
+    FrameHeader decoded = checkedHeader(header);
+    uint64_t remaining = decoded.packetLength - StreamProtocol::HEADER_SIZE;
+    int target = Lookup(decoded);
+
+    if (target == NO_ROUTE) {
+        // 경로가 없으면 나머지 바이트를 읽어 버립니다.
+        scratch.resize(COPY_CHUNK);
+        while (remaining > 0) {
+            size_t want = static_cast<size_t>(std::min<uint64_t>(remaining, scratch.size()));
+            if (!readFully(inFd, scratch.data(), want)) {
+                throw PacketException("connection closed mid-frame");
+            }
+            remaining -= want;
+        }
+        ++stats.framesDropped;
+        return true;
+    }
+
+    writeAll(target, header, sizeof(header), true);
+
+    bool useSplice = true;
+    size_t inPipe = 0;      // 파이프에 들어 있지만 아직 대상으로 나가지 않은 바이트
+    while (remaining > 0 || inPipe > 0) {
+        if (useSplice && remaining > 0) {
+            ssize_t moved = ::splice(inFd, nullptr, pipeFds[1], nullptr,
+                                     static_cast<size_t>(std::min<uint64_t>(remaining, 1u << 20)),
+                                     SPLICE_F_MOVE | SPLICE_F_MORE);
+            if (moved < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EINVAL && inPipe == 0) {
+                    useSplice = false;     // splice 를 지원하지 않는 입력: 이후로는 복사
+                    continue;
+                }
+                throwErrno("splice");
+            }
+            if (moved == 0) {
+                throw PacketException("connection closed mid-frame");
+            }
+            remaining -= static_cast<uint64_t>(moved);
+            inPipe += static_cast<size_t>(moved);
+        }
+        if (!useSplice) {
+            scratch.resize(COPY_CHUNK);
+            size_t want = static_cast<size_t>(std::min<uint64_t>(remaining, scratch.size()));
+            if (!readFully(inFd, scratch.data(), want)) {
+                throw PacketException("connection closed mid-frame");
+            }
+            remaining -= want;
+            writeAll(target, scratch.data(), want, remaining > 0);
+            continue;
+        }
+        while (inPipe > 0) {
+            ssize_t moved = ::splice(pipeFds[0], nullptr, target, nullptr, inPipe,
+                                     SPLICE_F_MOVE | (remaining > 0 ? SPLICE_F_MORE : 0));
+            if (moved < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EINVAL) {
+                    throwErrno("splice");
+                }
+                // 대상이 splice 를 받지 못하면 파이프에 든 바이트를 꺼내 직접 씁니다.
+                // 프레임의 마지막 조각에는 MSG_MORE 를 붙이지 않아 바로 전송되게 합니다.
+                scratch.resize(COPY_CHUNK);
+                size_t chunk = std::min(inPipe, scratch.size());
+                moved = ::read(pipeFds[0], scratch.data(), chunk);
+                if (moved < 0) {
+                    throwErrno("read");
+                }
+                bool more = remaining > 0 || inPipe > static_cast<size_t>(moved);
+                writeAll(target, scratch.data(), static_cast<size_t>(moved), more);
+            }
+            inPipe -= static_cast<size_t>(moved);
+        }
+    }
+
+    ++stats.framesForwarded;
+    stats.bytesForwarded += decoded.packetLength;
+    return true;
+}
+
+#endif // __linux__
+
+} // namespace streamprotocol
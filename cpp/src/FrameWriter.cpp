@@ -0,0 +1,154 @@
+#include "streamprotocol/FrameWriter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <system_error>
+#include <unistd.h>
+#endif
+
+namespace streamprotocol {
+
+FrameWriter::FrameWriter(const StreamProtocol& protocol, Sink sink, size_t chunkSize)
+    : protocol(protocol), sink(std::move(sink)), chunk(chunkSize) {
+    if (!this->sink) {
+        throw std::invalid_argument("sink must not be empty");
+    }
+    if (chunkSize == 0) {
+        throw std::invalid_argument("chunkSize must be non-zero");
+    }
+}
+
+void FrameWriter::requireFrame() const {
+    if (!inFrame) {
+        throw std::logic_error("FrameWriter: no frame in progress (call begin() first)");
+    }
+}
+
+void FrameWriter::begin(uint64_t payloadSize, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) {
+    if (inFrame) {
+        throw std::logic_error("FrameWriter: previous frame is not finished");
+    }
+    if (payloadSize > StreamProtocol::MAX_PAYLOAD_LENGTH) {
+        throw PayloadTooLargeException(payloadSize, StreamProtocol::MAX_PAYLOAD_LENGTH);
+    }
+
+    uint8_t header[StreamProtocol::HEADER_SIZE];
+    protocol.encodeHeader(header, static_cast<size_t>(payloadSize), payloadType, fragFlag, userValue);
+
+    crc = Crc32(Crc32::ForVersion(protocol.ProtocolVersion()));
+    crc.update(header, sizeof(header));
+    remaining = payloadSize;
+    frameLength = StreamProtocol::FRAME_OVERHEAD + payloadSize;
+    inFrame = true;
+
+    sink(header, sizeof(header));
+}
+
+void FrameWriter::write(const uint8_t* data, size_t size) {
+    requireFrame();
+    if (size == 0) {
+        return;
+    }
+    if (data == nullptr) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    if (size > remaining) {
+        throw PacketException("FrameWriter overrun: " + std::to_string(size) + " bytes written, " +
+                              std::to_string(remaining) + " bytes left in frame");
+    }
+
+    crc.update(data, size);
+    remaining -= size;
+    sink(data, size);
+}
+
+uint64_t FrameWriter::writeFrom(std::istream& in, uint64_t maxBytes) {
+    requireFrame();
+    uint64_t limit = std::min(maxBytes, remaining);
+    uint64_t total = 0;
+    while (total < limit) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(limit - total, chunk.size()));
+        in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(want));
+        size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0) {
+            break;
+        }
+        write(chunk.data(), got);
+        total += got;
+    }
+    return total;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+uint64_t FrameWriter::writeFromFd(int fd, uint64_t maxBytes) {
+    requireFrame();
+    uint64_t limit = std::min(maxBytes, remaining);
+    uint64_t total = 0;
+    while (total < limit) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(limit - total, chunk.size()));
+        ssize_t got = ::read(fd, chunk.data(), want);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (got == 0) {
+            break;
+        }
+        write(chunk.data(), static_cast<size_t>(got));
+        total += static_cast<uint64_t>(got);
+    }
+    return total;
+}
+#endif
+
+uint64_t FrameWriter::finish() {
+    requireFrame();
+    if (remaining != 0) {
+        throw PacketException("FrameWriter underrun: " + std::to_string(remaining) +
+                              " payload bytes missing (declared frame length: " + std::to_string(frameLength) + ")");
+    }
+
+    uint32_t value = crc.value();
+    uint8_t trailer[sizeof(uint32_t)];
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        trailer[i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFFu);
+    }
+    inFrame = false;
+    sink(trailer, sizeof(trailer));
+    return frameLength;
+}
+
+FrameWriter::Sink FrameWriter::StreamSink(std::ostream& out) {
+    return [&out](const uint8_t* data, size_t size) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!out) {
+            throw std::runtime_error("FrameWriter: output stream write failed");
+        }
+    };
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+FrameWriter::Sink FrameWriter::FdSink(int fd) {
+    return [fd](const uint8_t* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "write");
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    };
+}
+#endif
+
+} // namespace streamprotocol
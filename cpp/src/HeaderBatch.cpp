@@ -0,0 +1,209 @@
+#include "streamprotocol/HeaderBatch.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define STREAMPROTOCOL_HEADER_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define STREAMPROTOCOL_HEADER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr uint64_t MIN_PACKET_LENGTH = StreamProtocol::FRAME_OVERHEAD;
+constexpr uint64_t LENGTH_MASK = 0x1FFFFFFFFFFFull;
+
+size_t decodeScalar(const uint8_t* base, const uint64_t* offsets, size_t begin, size_t count, const HeaderColumns& out,
+                    uint64_t maxPacketLength) {
+    size_t invalid = 0;
+    for (size_t i = begin; i < count; ++i) {
+        const uint8_t* header = base + offsets[i];
+        uint64_t headerValue = 0;
+        for (size_t b = 0; b < StreamProtocol::HEADER_SIZE; ++b) {
+            headerValue |= static_cast<uint64_t>(header[b]) << (b * 8);
+        }
+
+        uint64_t length = (headerValue >> 4) & LENGTH_MASK;
+        out.protocolVersion[i] = static_cast<uint8_t>(headerValue & 0x0F);
+        out.packetLength[i] = length;
+        out.fragmentFlag[i] = static_cast<uint8_t>((headerValue >> 49) & 0x01);
+        out.payloadType[i] = static_cast<uint8_t>((headerValue >> 50) & 0x0F);
+        out.userField[i] = static_cast<uint16_t>((headerValue >> 54) & 0x3FF);
+
+        bool ok = length >= MIN_PACKET_LENGTH && length <= maxPacketLength;
+        out.valid[i] = ok ? 1 : 0;
+        invalid += ok ? 0 : 1;
+    }
+    return invalid;
+}
+
+#if defined(STREAMPROTOCOL_HEADER_AVX2)
+__attribute__((target("avx2")))
+size_t decodeAvx2(const uint8_t* base, const uint64_t* offsets, size_t count, const HeaderColumns& out,
+                  uint64_t maxPacketLength, size_t& done) {
+    const __m256i lengthMask = _mm256_set1_epi64x(static_cast<long long>(LENGTH_MASK));
+    const __m256i nibbleMask = _mm256_set1_epi64x(0x0F);
+    const __m256i bitMask = _mm256_set1_epi64x(0x01);
+    const __m256i belowMin = _mm256_set1_epi64x(static_cast<long long>(MIN_PACKET_LENGTH - 1));
+    const __m256i aboveMax = _mm256_set1_epi64x(static_cast<long long>(maxPacketLength));
+    // 레인마다 [version, frag, type, -, userLo, userHi, -, -] 로 모은 뒤,
+    // 128비트 절반마다 두 레인의 같은 필드를 이웃하게 모읍니다: ver(0,1) frag(2,3) type(4,5) user(6..9)
+    const __m256i gatherFields = _mm256_setr_epi8(
+        0, 8, 1, 9, 2, 10, 4, 5, 12, 13, -1, -1, -1, -1, -1, -1,
+        0, 8, 1, 9, 2, 10, 4, 5, 12, 13, -1, -1, -1, -1, -1, -1);
+
+    size_t invalid = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i));
+        __m256i header = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), index, 1);
+
+        __m256i length = _mm256_and_si256(_mm256_srli_epi64(header, 4), lengthMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.packetLength + i), length);
+
+        // 길이 범위 검증 (45비트 값이므로 부호 있는 비교로 충분)
+        __m256i ok = _mm256_andnot_si256(_mm256_cmpgt_epi64(length, aboveMax), _mm256_cmpgt_epi64(length, belowMin));
+        int okMask = _mm256_movemask_pd(_mm256_castsi256_pd(ok));
+        for (int lane = 0; lane < 4; ++lane) {
+            out.valid[i + lane] = static_cast<uint8_t>((okMask >> lane) & 1);
+        }
+        invalid += 4 - static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(okMask)));
+
+        __m256i packed = _mm256_and_si256(header, nibbleMask);
+        packed = _mm256_or_si256(packed, _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(header, 49), bitMask), 8));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(header, 50), nibbleMask), 16));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi64(_mm256_srli_epi64(header, 54), 32));
+        __m256i fields = _mm256_shuffle_epi8(packed, gatherFields);
+
+        alignas(32) uint8_t lanes[32];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), fields);
+        for (int half = 0; half < 2; ++half) {
+            const uint8_t* src = lanes + half * 16;
+            size_t at = i + static_cast<size_t>(half) * 2;
+            std::memcpy(out.protocolVersion + at, src + 0, 2);
+            std::memcpy(out.fragmentFlag + at, src + 2, 2);
+            std::memcpy(out.payloadType + at, src + 4, 2);
+            std::memcpy(out.userField + at, src + 6, 4);
+        }
+    }
+    done = i;
+    return invalid;
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+#if defined(STREAMPROTOCOL_HEADER_NEON)
+size_t decodeNeon(const uint8_t* base, const uint64_t* offsets, size_t count, const HeaderColumns& out,
+                  uint64_t maxPacketLength, size_t& done) {
+    const uint64x2_t lengthMask = vdupq_n_u64(LENGTH_MASK);
+    const uint64x2_t minLength = vdupq_n_u64(MIN_PACKET_LENGTH);
+    const uint64x2_t maxLength = vdupq_n_u64(maxPacketLength);
+
+    size_t invalid = 0;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t header = vcombine_u64(vreinterpret_u64_u8(vld1_u8(base + offsets[i])),
+                                         vreinterpret_u64_u8(vld1_u8(base + offsets[i + 1])));
+
+        uint64x2_t length = vandq_u64(vshrq_n_u64(header, 4), lengthMask);
+        vst1q_u64(out.packetLength + i, length);
+        uint64x2_t ok = vandq_u64(vcgeq_u64(length, minLength), vcleq_u64(length, maxLength));
+
+        uint64x2_t frag = vandq_u64(vshrq_n_u64(header, 49), vdupq_n_u64(0x01));
+        uint64x2_t type = vandq_u64(vshrq_n_u64(header, 50), vdupq_n_u64(0x0F));
+        uint64x2_t user = vshrq_n_u64(header, 54);
+        out.protocolVersion[i] = static_cast<uint8_t>(vgetq_lane_u64(header, 0) & 0x0F);
+        out.protocolVersion[i + 1] = static_cast<uint8_t>(vgetq_lane_u64(header, 1) & 0x0F);
+        out.fragmentFlag[i] = static_cast<uint8_t>(vgetq_lane_u64(frag, 0));
+        out.fragmentFlag[i + 1] = static_cast<uint8_t>(vgetq_lane_u64(frag, 1));
+        out.payloadType[i] = static_cast<uint8_t>(vgetq_lane_u64(type, 0));
+        out.payloadType[i + 1] = static_cast<uint8_t>(vgetq_lane_u64(type, 1));
+        out.userField[i] = static_cast<uint16_t>(vgetq_lane_u64(user, 0));
+        out.userField[i + 1] = static_cast<uint16_t>(vgetq_lane_u64(user, 1));
+
+        uint8_t ok0 = vgetq_lane_u64(ok, 0) != 0 ? 1 : 0;
+        uint8_t ok1 = vgetq_lane_u64(ok, 1) != 0 ? 1 : 0;
+        out.valid[i] = ok0;
+        out.valid[i + 1] = ok1;
+        invalid += static_cast<size_t>(2 - ok0 - ok1);
+    }
+    done = i;
+    return invalid;
+}
+#endif
+
+} // namespace
+
+size_t decodeHeaderColumns(const uint8_t* base, const uint64_t* offsets, size_t count, const HeaderColumns& out,
+                           uint64_t maxPacketLength) {
+    if (count == 0) {
+        return 0;
+    }
+    if (base == nullptr || offsets == nullptr || out.protocolVersion == nullptr || out.packetLength == nullptr ||
+        out.fragmentFlag == nullptr || out.payloadType == nullptr || out.userField == nullptr || out.valid == nullptr) {
+        throw std::invalid_argument("decodeHeaderColumns: null input or output array");
+    }
+    if (maxPacketLength > StreamProtocol::MAX_PACKET_LENGTH) {
+        maxPacketLength = StreamProtocol::MAX_PACKET_LENGTH;
+    }
+
+    size_t done = 0;
+    size_t invalid = 0;
+#if defined(STREAMPROTOCOL_HEADER_AVX2)
+    if (cpuHasAvx2()) {
+        invalid = decodeAvx2(base, offsets, count, out, maxPacketLength, done);
+    }
+#elif defined(STREAMPROTOCOL_HEADER_NEON)
+    invalid = decodeNeon(base, offsets, count, out, maxPacketLength, done);
+#endif
+    return invalid + decodeScalar(base, offsets, done, count, out, maxPacketLength);
+}
+
+const char* headerDecoderImplementation() {
+#if defined(STREAMPROTOCOL_HEADER_AVX2)
+    return cpuHasAvx2() ? "avx2" : "scalar";
+#elif defined(STREAMPROTOCOL_HEADER_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+size_t HeaderBatch::decode(const uint8_t* base, const uint64_t* offsets, size_t count, uint64_t maxPacketLength) {
+    protocolVersions.resize(count);
+    packetLengths.resize(count);
+    fragmentFlags.resize(count);
+    payloadTypes.resize(count);
+    userFields.resize(count);
+    valid.resize(count);
+
+    HeaderColumns columns{ protocolVersions.data(), packetLengths.data(), fragmentFlags.data(),
+                           payloadTypes.data(), userFields.data(), valid.data() };
+    size = count;
+    invalidCount = decodeHeaderColumns(base, offsets, count, columns, maxPacketLength);
+    return invalidCount;
+}
+
+FrameHeader HeaderBatch::at(size_t index) const {
+    if (index >= size) {
+        throw std::out_of_range("HeaderBatch index out of range");
+    }
+    FrameHeader header;
+    header.protocolVersion = protocolVersions[index];
+    header.packetLength = packetLengths[index];
+    header.fragmentFlag = fragmentFlags[index];
+    header.payloadType = payloadTypes[index];
+    header.userField = userFields[index];
+    return header;
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,121 @@
+#include "streamprotocol/HeaderTemplate.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr uint64_t LENGTH_MASK = 0x1FFFFFFFFFFFull << 4;     // 헤더 비트 4-48
+constexpr size_t LENGTH_BYTES = 7;                          // 길이 비트가 걸치는 헤더 바이트 0-6
+
+using LengthTables = std::array<std::array<uint32_t, 256>, LENGTH_BYTES>;
+
+uint32_t headerState(Crc32::Algorithm algorithm, uint64_t headerValue) {
+    uint8_t header[StreamProtocol::HEADER_SIZE];
+    for (size_t i = 0; i < sizeof(header); ++i) {
+        header[i] = static_cast<uint8_t>(headerValue >> (i * 8));
+    }
+    Crc32 crc(algorithm);
+    crc.update(header, sizeof(header));
+    return crc.State();
+}
+
+/// 헤더 바이트 p 가 v 일 때 CRC 상태에 더해지는 기여분입니다. (CRC 의 아핀성: S(a^b) = S(a)^S(b)^S(0))
+LengthTables buildLengthTables(Crc32::Algorithm algorithm) {
+    LengthTables tables{};
+    uint32_t zero = headerState(algorithm, 0);
+    for (size_t position = 0; position < LENGTH_BYTES; ++position) {
+        for (uint32_t value = 0; value < 256; ++value) {
+            tables[position][value] = headerState(algorithm, static_cast<uint64_t>(value) << (position * 8)) ^ zero;
+        }
+    }
+    return tables;
+}
+
+const LengthTables& lengthTables(Crc32::Algorithm algorithm) {
+    static const LengthTables ieee = buildLengthTables(Crc32::Algorithm::Ieee);
+    static const LengthTables castagnoli = buildLengthTables(Crc32::Algorithm::Castagnoli);
+    return algorithm == Crc32::Algorithm::Castagnoli ? castagnoli : ieee;
+}
+
+uint64_t lengthBitsFor(size_t payloadSize) {
+    uint64_t totalPacketLength64 = StreamProtocol::HEADER_SIZE + static_cast<uint64_t>(payloadSize) + sizeof(uint32_t);
+    if (payloadSize > StreamProtocol::MAX_PAYLOAD_LENGTH || totalPacketLength64 > StreamProtocol::MAX_PACKET_LENGTH) {
+        throw PayloadTooLargeException(totalPacketLength64, StreamProtocol::MAX_PACKET_LENGTH);
+    }
+    return totalPacketLength64 << 4;
+}
+
+} // namespace
+
+HeaderTemplate::HeaderTemplate(const StreamProtocol& protocol, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue)
+    : algorithm(Crc32::ForVersion(protocol.ProtocolVersion())) {
+    // 필드 검증과 비트 배치는 encodeHeader 에 맡기고, 길이 비트만 지운 값을 템플릿으로 씁니다.
+    uint8_t header[StreamProtocol::HEADER_SIZE];
+    protocol.encodeHeader(header, 0, payloadType, fragFlag, userValue);
+    uint64_t headerValue = 0;
+    for (size_t i = 0; i < sizeof(header); ++i) {
+        headerValue |= static_cast<uint64_t>(header[i]) << (i * 8);
+    }
+    fixedBits = headerValue & ~LENGTH_MASK;
+    baseState = headerState(algorithm, fixedBits);
+}
+
+uint32_t HeaderTemplate::stateFor(uint64_t lengthBits) const {
+    const LengthTables& tables = lengthTables(algorithm);
+    uint32_t state = baseState;
+    for (size_t position = 0; position < LENGTH_BYTES; ++position) {
+        state ^= tables[position][(lengthBits >> (position * 8)) & 0xFFu];
+    }
+    return state;
+}
+
+void HeaderTemplate::writeHeader(uint8_t* header, size_t payloadSize) const {
+    if (header == nullptr) {
+        throw std::invalid_argument("header must not be null");
+    }
+    uint64_t headerValue = fixedBits | lengthBitsFor(payloadSize);
+    for (size_t i = 0; i < StreamProtocol::HEADER_SIZE; ++i) {
+        header[i] = static_cast<uint8_t>(headerValue >> (i * 8));
+    }
+}
+
+Crc32 HeaderTemplate::crcAfterHeader(size_t payloadSize) const {
+    return Crc32(algorithm, stateFor(lengthBitsFor(payloadSize)));
+}
+
+size_t HeaderTemplate::encodeInto(const uint8_t* data, size_t size, uint8_t* out, size_t capacity) const {
+    if (out == nullptr || (data == nullptr && size != 0)) {
+        throw std::invalid_argument("data and out must not be null");
+    }
+    uint64_t lengthBits = lengthBitsFor(size);
+    size_t frameSize = size + StreamProtocol::FRAME_OVERHEAD;
+    if (capacity < frameSize) {
+        throw std::invalid_argument("output buffer too small for frame");
+    }
+
+    uint64_t headerValue = fixedBits | lengthBits;
+    for (size_t i = 0; i < StreamProtocol::HEADER_SIZE; ++i) {
+        out[i] = static_cast<uint8_t>(headerValue >> (i * 8));
+    }
+
+    Crc32 crc(algorithm, stateFor(lengthBits));
+    crc.copyUpdate(out + StreamProtocol::HEADER_SIZE, data, size);
+    uint32_t value = crc.value();
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        out[StreamProtocol::HEADER_SIZE + size + i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+    return frameSize;
+}
+
+std::vector<uint8_t> HeaderTemplate::encode(const uint8_t* data, size_t size) const {
+    // lengthBitsFor 가 먼저 크기를 검증하므로 vector 크기 계산이 넘치지 않습니다.
+    lengthBitsFor(size);
+    std::vector<uint8_t> frame(size + StreamProtocol::FRAME_OVERHEAD);
+    encodeInto(data, size, frame.data(), frame.size());
+    return frame;
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,89 @@
+#include "streamprotocol/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace streamprotocol {
+
+namespace {
+
+constexpr size_t BUCKET_ARRAY_SIZE = (64 - 7 + 1) * 64 + 64;   // 모든 uint64 값을 덮는 인덱스 수
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKET_ARRAY_SIZE, 0) {
+}
+
+size_t LatencyHistogram::indexOf(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    // value 의 최상위 비트가 하위 구간 범위 [64, 128) 에 오도록 내린 만큼이 구간 번호입니다.
+    unsigned magnitude = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    unsigned shift = magnitude - (SUB_BUCKET_BITS - 1);
+    uint64_t subBucket = value >> shift;
+    return static_cast<size_t>(shift * SUB_BUCKET_HALF + subBucket);
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    uint64_t shift = (index - SUB_BUCKET_HALF) / SUB_BUCKET_HALF;
+    uint64_t subBucket = index - shift * SUB_BUCKET_HALF;
+    uint64_t low = subBucket << shift;
+    return low + ((1ull << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t valueNs) {
+    recordMany(valueNs, 1);
+}
+
+void LatencyHistogram::recordMany(uint64_t valueNs, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    counts[indexOf(valueNs)] += count;
+    total += count;
+    minValue = std::min(minValue, valueNs);
+    maxValue = std::max(maxValue, valueNs);
+    sum += static_cast<long double>(valueNs) * count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    minValue = UINT64_MAX;
+    maxValue = 0;
+    sum = 0;
+}
+
+uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+    if (total == 0) {
+        return 0;
+    }
+    percentile = std::min(100.0, std::max(0.0, percentile));
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+    target = std::max<uint64_t>(1, target);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(highestEquivalentValue(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+} // namespace streamprotocol
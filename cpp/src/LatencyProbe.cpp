@@ -0,0 +1,139 @@
+#include "streamprotocol/LatencyProbe.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "streamprotocol/PacketException.h"
+
+#include "Detail.hpp"
+
+namespace streamprotocol {
+
+namespace {
+
+uint64_t toNs(std::chrono::steady_clock::time_point time) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
+
+} // namespace
+
+LatencyProbeSender::LatencyProbeSender(StreamProtocol& protocol)
+    : LatencyProbeSender(protocol, Options()) {
+}
+
+LatencyProbeSender::LatencyProbeSender(StreamProtocol& protocol, const Options& options)
+    : protocol(protocol), options(options), countdown(options.sampleEvery) {
+    if (options.sampleEvery == 0) {
+        throw std::invalid_argument("sampleEvery must be at least 1");
+    }
+    if (options.minInterval < std::chrono::nanoseconds::zero()) {
+        throw std::invalid_argument("minInterval must not be negative");
+    }
+    if (options.userField > 0x3FF) {
+        throw std::invalid_argument("userField must be 10-bit (0-1023)");
+    }
+}
+
+bool LatencyProbeSender::tick() {
+    if (--countdown != 0) {
+        return false;
+    }
+    countdown = options.sampleEvery;
+    if (options.minInterval == std::chrono::nanoseconds::zero() || sequence == 0) {
+        return true;
+    }
+    // 표본 시점에만 시계를 읽습니다.
+    return Clock::now() - lastProbe >= options.minInterval;
+}
+
+void LatencyProbeSender::writePayload(uint8_t* out, Clock::time_point now) {
+    detail::putLE64(out, sequence);
+    detail::putLE64(out + 8, toNs(now));
+    ++sequence;
+    lastProbe = now;
+}
+
+std::vector<uint8_t> LatencyProbeSender::makeProbe(Clock::time_point now) {
+    uint8_t payload[LatencyProbePayload::SIZE];
+    writePayload(payload, now);
+    return protocol.toBytes(payload, sizeof(payload), PayloadType::PROBE, StreamProtocol::UNFRAGED, options.userField);
+}
+
+size_t LatencyProbeSender::encodeProbe(uint8_t* out, size_t capacity, Clock::time_point now) {
+    if (out == nullptr) {
+        throw std::invalid_argument("output buffer must not be null");
+    }
+    if (capacity < FRAME_SIZE) {
+        throw PayloadTooLargeException(FRAME_SIZE, capacity);
+    }
+    uint8_t payload[LatencyProbePayload::SIZE];
+    writePayload(payload, now);
+    return protocol.encodeInto(payload, sizeof(payload), out, capacity, PayloadType::PROBE, StreamProtocol::UNFRAGED,
+                               options.userField);
+}
+
+LatencyProbeReceiver::LatencyProbeReceiver()
+    : LatencyProbeReceiver(Options()) {
+}
+
+LatencyProbeReceiver::LatencyProbeReceiver(const Options& options)
+    : options(options) {
+}
+
+LatencyProbePayload LatencyProbeReceiver::Decode(const uint8_t* payload, size_t size) {
+    if (payload == nullptr || size < LatencyProbePayload::SIZE) {
+        throw PacketException("Probe payload too short: " + std::to_string(size) + " bytes (min: " +
+                              std::to_string(LatencyProbePayload::SIZE) + ")");
+    }
+    LatencyProbePayload probe;
+    probe.sequence = detail::getLE64(payload);
+    probe.timestampNs = detail::getLE64(payload + 8);
+    return probe;
+}
+
+bool LatencyProbeReceiver::accept(const ParsedPacketView& frame, Clock::time_point now) {
+    if (frame.PayloadType() != PayloadType::PROBE) {
+        return false;
+    }
+    record(frame.Payload(), frame.PayloadSize(), now);
+    return true;
+}
+
+void LatencyProbeReceiver::record(const uint8_t* payload, size_t size, Clock::time_point now) {
+    if (payload == nullptr || size < LatencyProbePayload::SIZE) {
+        stats.malformed++;
+        return;
+    }
+    LatencyProbePayload probe = Decode(payload, size);
+
+    if (!started || probe.sequence >= nextSequence) {
+        if (started) {
+            stats.lost += probe.sequence - nextSequence;
+        }
+        nextSequence = probe.sequence + 1;
+        started = true;
+    } else {
+        // 늦게 온 측정 프레임은 앞서 유실로 셌던 것이므로 되돌립니다.
+        stats.reordered++;
+        if (stats.lost != 0) {
+            stats.lost--;
+        }
+    }
+
+    int64_t received = static_cast<int64_t>(toNs(now)) - options.clockOffset.count();
+    int64_t latency = received - static_cast<int64_t>(probe.timestampNs);
+    if (latency < 0) {
+        stats.clockSkew++;
+        latency = 0;
+    }
+    histogram.record(static_cast<uint64_t>(latency));
+    stats.probes++;
+}
+
+void LatencyProbeReceiver::reset() {
+    histogram.reset();
+    stats = Metrics();
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,344 @@
+#include "streamprotocol/ReceivePipeline.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace streamprotocol {
+
+ReceivePipeline::Worker::Worker(size_t capacity) {
+    size_t slotCount = 1;
+    while (slotCount < capacity) {
+        slotCount <<= 1;
+    }
+    slots.reset(new Slot[slotCount]);
+    for (size_t i = 0; i < slotCount; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = slotCount - 1;
+}
+
+void ReceivePipeline::Worker::push(Task&& task) {
+    // seq_cst: 잠들기 전 워커가 sleeping 을 켜고 Empty() 로 다시 보는 순서와 짝을 이룹니다.
+    uint64_t position = head.fetch_add(1);
+    Slot& slot = slots[position & mask];
+    // 용량이 maxInFlight 이상이므로 이 슬롯의 이전 작업은 이미 꺼내졌거나 꺼내지는 중입니다.
+    // 꺼내는 워커가 Task 를 옮기는 동안에만 기다립니다.
+    while (slot.sequence.load(std::memory_order_acquire) != position) {
+        std::this_thread::yield();
+    }
+    slot.task = std::move(task);
+    slot.sequence.store(position + 1, std::memory_order_release);
+}
+
+bool ReceivePipeline::Worker::pop(Task& task) {
+    uint64_t position = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[position & mask];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence - (position + 1));
+        if (diff == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                task = std::move(slot.task);
+                slot.sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;           // 비어 있거나 생산자가 아직 쓰는 중
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ReceivePipeline::Worker::Empty() const {
+    return tail.load() == head.load();
+}
+
+ReceivePipeline::ReceivePipeline(const StreamProtocol& protocol, PacketHandler onPacket, ErrorHandler onError)
+    : ReceivePipeline(protocol, std::move(onPacket), std::move(onError), Options()) {
+}
+
+ReceivePipeline::ReceivePipeline(const StreamProtocol& protocol, PacketHandler onPacket, ErrorHandler onError,
+                                 const Options& options)
+    : protocol(protocol), packetHandler(std::move(onPacket)), errorHandler(std::move(onError)), options(options) {
+    if (!packetHandler || !errorHandler) {
+        throw std::invalid_argument("ReceivePipeline requires packet and error handlers");
+    }
+    if (this->options.maxInFlight == 0) {
+        throw std::invalid_argument("maxInFlight must be at least 1");
+    }
+    size_t count = this->options.workers;
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        workers.emplace_back(new Worker(this->options.maxInFlight));
+    }
+    threads.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back(&ReceivePipeline::workerLoop, this, i);
+    }
+}
+
+ReceivePipeline::~ReceivePipeline() {
+    drain();
+    stopping.store(true);
+    for (const std::unique_ptr<Worker>& worker : workers) {
+        wakeWorker(*worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+uint64_t ReceivePipeline::orderKeyFor(uint64_t stream, const std::vector<uint8_t>& frame) const {
+    if (!options.orderByUserField) {
+        return stream;
+    }
+    // userField: 헤더 비트 54-63 (바이트 6 의 상위 2비트 + 바이트 7). 검증 전이지만 순서 분류에만 씁니다.
+    uint16_t userField = 0;
+    if (frame.size() >= StreamProtocol::HEADER_SIZE) {
+        userField = static_cast<uint16_t>((frame[6] >> 6) | (static_cast<uint16_t>(frame[7]) << 2));
+    }
+    return (stream << 10) | userField;
+}
+
+void ReceivePipeline::acquireSlot() {
+    size_t current = inFlight.load(std::memory_order_relaxed);
+    for (;;) {
+        if (current < options.maxInFlight) {
+            if (inFlight.compare_exchange_weak(current, current + 1, std::memory_order_relaxed)) {
+                return;
+            }
+            continue;
+        }
+        // 느린 경로: 전달이 끝나 자리가 날 때까지 잠듭니다. capacityWaiters 는 releaseSlots() 와 짝을 이룹니다.
+        std::unique_lock<std::mutex> lock(waitMutex);
+        capacityWaiters.fetch_add(1);
+        capacityAvailable.wait(lock, [this] { return inFlight.load() < options.maxInFlight; });
+        capacityWaiters.fetch_sub(1);
+        current = inFlight.load(std::memory_order_relaxed);
+    }
+}
+
+void ReceivePipeline::releaseSlots(size_t count) {
+    size_t remaining = inFlight.fetch_sub(count) - count;
+    bool wakeSubmitters = capacityWaiters.load() > 0;
+    bool wakeDrain = remaining == 0 && drainWaiters.load() > 0;
+    if (!wakeSubmitters && !wakeDrain) {
+        return;
+    }
+    {
+        // 기다리는 쪽이 조건을 확인하고 wait() 에 들어가는 사이에 알림이 빠지지 않도록 락을 한 번 거칩니다.
+        std::lock_guard<std::mutex> lock(waitMutex);
+    }
+    if (wakeSubmitters) {
+        capacityAvailable.notify_all();
+    }
+    if (wakeDrain) {
+        drained.notify_all();
+    }
+}
+
+void ReceivePipeline::submit(uint64_t stream, std::vector<uint8_t>&& frame) {
+    if (options.orderByUserField && stream >= (1ull << 54)) {
+        throw std::invalid_argument("stream must be below 2^54 when ordering by userField");
+    }
+    uint64_t orderKey = orderKeyFor(stream, frame);
+    acquireSlot();
+
+    uint64_t sequence;
+    {
+        OrderShard& shard = shardFor(orderKey);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        sequence = shard.states[orderKey].nextSubmit++;
+    }
+
+    size_t target = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    Worker& worker = *workers[target];
+    worker.push(Task{ stream, orderKey, sequence, std::move(frame) });
+
+    // 워커는 sleeping 을 켠 뒤 큐를 다시 확인하고 잠듭니다. 둘 다 seq_cst 이므로
+    // 워커가 이 push 를 못 봤다면 여기서는 반드시 sleeping 을 봅니다.
+    if (worker.sleeping.load()) {
+        wakeWorker(worker);
+    } else {
+        wakeIdlePeer(target);
+    }
+}
+
+bool ReceivePipeline::takeTask(size_t self, Task& task) {
+    // 자기 큐를 먼저 보고, 비어 있으면 다른 워커의 큐에서 가장 오래된 작업을 가져옵니다.
+    for (size_t i = 0; i < workers.size(); ++i) {
+        if (workers[(self + i) % workers.size()]->pop(task)) {
+            if (i != 0) {
+                workers[self]->stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReceivePipeline::wakeWorker(Worker& worker) {
+    std::lock_guard<std::mutex> lock(worker.sleepMutex);
+    if (!worker.signaled) {
+        worker.signaled = true;
+        worker.wake.notify_one();
+    }
+}
+
+void ReceivePipeline::wakeIdlePeer(size_t self) {
+    // 잠든 워커가 있을 때만 훑습니다. 바쁜 워커 큐에 쌓인 작업을 잠든 워커가 훔쳐 가게 합니다.
+    if (sleepers.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    for (size_t i = 1; i < workers.size(); ++i) {
+        Worker& peer = *workers[(self + i) % workers.size()];
+        if (peer.sleeping.load(std::memory_order_relaxed)) {
+            wakeWorker(peer);
+            return;
+        }
+    }
+}
+
+void ReceivePipeline::workerLoop(size_t self) {
+    Worker& me = *workers[self];
+    for (;;) {
+        Task task;
+        if (takeTask(self, task)) {
+            if (!me.Empty()) {
+                wakeIdlePeer(self);
+            }
+            Result result = validate(std::move(task.frame));
+            me.processed.fetch_add(1, std::memory_order_relaxed);
+            complete(task, std::move(result));
+            continue;
+        }
+        if (stopping.load()) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(me.sleepMutex);
+        me.sleeping.store(true);
+        sleepers.fetch_add(1, std::memory_order_relaxed);
+        // 여기서 빈 큐를 봤다면 그 뒤의 push 는 sleeping 을 보고 깨웁니다. (submit() 참고)
+        bool idle = true;
+        for (const std::unique_ptr<Worker>& worker : workers) {
+            if (!worker->Empty()) {
+                idle = false;
+                break;
+            }
+        }
+        if (idle) {
+            me.wake.wait(lock, [&] { return me.signaled || stopping.load(); });
+        }
+        me.signaled = false;
+        me.sleeping.store(false, std::memory_order_relaxed);
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+ReceivePipeline::Result ReceivePipeline::validate(std::vector<uint8_t>&& frame) const {
+    Result result;
+    try {
+        // 페이로드는 프레임 버퍼 안(HEADER_SIZE 오프셋)을 그대로 가리킵니다. 벡터를 옮겨도 버퍼는 움직이지 않습니다.
+        result.packet = protocol.parsePacketView(frame.data(), frame.size());
+        result.frame = std::move(frame);
+    } catch (const PacketException&) {
+        result.error = std::current_exception();
+    }
+    return result;
+}
+
+void ReceivePipeline::growWindow(OrderState& state, uint64_t sequence) {
+    size_t size = state.completed.empty() ? MIN_ORDER_WINDOW : state.completed.size();
+    while (sequence - state.nextDeliver >= size) {
+        size *= 2;
+    }
+    std::vector<Result> window(size);
+    for (uint64_t s = state.nextDeliver; s < state.nextDeliver + state.completed.size(); ++s) {
+        Result& slot = state.completed[s & (state.completed.size() - 1)];
+        if (slot.ready) {
+            window[s & (size - 1)] = std::move(slot);
+        }
+    }
+    state.completed.swap(window);
+}
+
+void ReceivePipeline::complete(const Task& task, Result&& result) {
+    OrderShard& shard = shardFor(task.orderKey);
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    OrderState& state = shard.states[task.orderKey];
+    if (task.sequence - state.nextDeliver >= state.completed.size()) {
+        growWindow(state, task.sequence);
+    }
+    result.ready = true;
+    state.completed[task.sequence & (state.completed.size() - 1)] = std::move(result);
+    if (state.delivering) {
+        // 다른 워커가 이 순서 단위를 전달하는 중이면 그 워커가 이어서 전달합니다.
+        return;
+    }
+
+    state.delivering = true;
+    size_t delivered = 0;
+    while (true) {
+        // 링은 다른 워커의 complete() 에서 커질 수 있으므로 매번 다시 찾습니다.
+        Result& slot = state.completed[state.nextDeliver & (state.completed.size() - 1)];
+        if (!slot.ready) {
+            break;
+        }
+        Result ready = std::move(slot);
+        slot.ready = false;
+        ++state.nextDeliver;
+
+        lock.unlock();
+        if (ready.error) {
+            errorHandler(task.stream, ready.error);
+        } else {
+            packetHandler(task.stream, ready.packet, std::move(ready.frame));
+        }
+        ++delivered;
+        lock.lock();
+    }
+    state.delivering = false;
+    lock.unlock();
+
+    if (delivered > 0) {
+        releaseSlots(delivered);
+    }
+}
+
+void ReceivePipeline::drain() {
+    std::unique_lock<std::mutex> lock(waitMutex);
+    drainWaiters.fetch_add(1);
+    drained.wait(lock, [this] { return inFlight.load() == 0; });
+    drainWaiters.fetch_sub(1);
+}
+
+void ReceivePipeline::closeStream(uint64_t stream) {
+    for (OrderShard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.states.begin(); it != shard.states.end();) {
+            uint64_t owner = options.orderByUserField ? (it->first >> 10) : it->first;
+            if (owner == stream && it->second.nextDeliver == it->second.nextSubmit && !it->second.delivering) {
+                it = shard.states.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+ReceivePipeline::WorkerStats ReceivePipeline::Stats(size_t worker) const {
+    if (worker >= workers.size()) {
+        throw std::out_of_range("worker index out of range");
+    }
+    WorkerStats stats;
+    stats.processed = workers[worker]->processed.load(std::memory_order_relaxed);
+    stats.stolen = workers[worker]->stolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace streamprotocol
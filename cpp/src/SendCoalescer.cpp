@@ -0,0 +1,183 @@
+#include "streamprotocol/SendCoalescer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "streamprotocol/PacketException.h"
+#include "streamprotocol/StreamProtocol.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <climits>
+#include <system_error>
+#include <sys/uio.h>
+#endif
+
+namespace streamprotocol {
+
+SendCoalescer::SendCoalescer(Sink sink)
+    : SendCoalescer(std::move(sink), Options()) {
+}
+
+SendCoalescer::SendCoalescer(Sink sink, const Options& options)
+    : sink(std::move(sink)), options(options) {
+    if (!this->sink) {
+        throw std::invalid_argument("sink must not be empty");
+    }
+    if (options.maxBatchFrames == 0) {
+        throw std::invalid_argument("maxBatchFrames must be at least 1");
+    }
+    levelDelay.fill(std::chrono::nanoseconds::zero());
+    levelDelay[0] = options.maxDelay;
+}
+
+void SendCoalescer::SetPriority(uint8_t payloadType, uint8_t level) {
+    if (payloadType > 0x0F) {
+        throw std::invalid_argument("payloadType must be 4 bits (0-15)");
+    }
+    if (level >= PRIORITY_LEVELS) {
+        throw std::invalid_argument("priority level must be 0-3");
+    }
+    priorityOf[payloadType] = level;
+}
+
+void SendCoalescer::SetLevelDelay(uint8_t level, std::chrono::nanoseconds maxDelay) {
+    if (level >= PRIORITY_LEVELS) {
+        throw std::invalid_argument("priority level must be 0-3");
+    }
+    levelDelay[level] = maxDelay;
+}
+
+bool SendCoalescer::enqueue(std::vector<uint8_t>&& frame, Clock::time_point now) {
+    if (frame.size() < StreamProtocol::FRAME_OVERHEAD) {
+        throw BufferTooSmallException(frame.size());
+    }
+    // payloadType: 헤더 비트 50-53 = 7번째 바이트(인덱스 6)의 비트 2-5
+    uint8_t payloadType = static_cast<uint8_t>((frame[6] >> 2) & 0x0Fu);
+    uint8_t level = priorityOf[payloadType];
+
+    pendingBytes += frame.size();
+    ++pendingFrames;
+    queues[level].push_back(Pending{ std::move(frame), now });
+
+    if (pendingBytes >= options.maxBatchBytes) {
+        flushNow(FlushReason::Size);
+        return true;
+    }
+    if (pendingFrames >= options.maxBatchFrames) {
+        flushNow(FlushReason::Count);
+        return true;
+    }
+    if (levelDelay[level] <= std::chrono::nanoseconds::zero()) {
+        flushNow(FlushReason::Priority);
+        return true;
+    }
+    return false;
+}
+
+bool SendCoalescer::enqueue(const uint8_t* frame, size_t size, Clock::time_point now) {
+    if (frame == nullptr) {
+        throw std::invalid_argument("frame must not be null");
+    }
+    return enqueue(std::vector<uint8_t>(frame, frame + size), now);
+}
+
+SendCoalescer::Clock::time_point SendCoalescer::NextDeadline() const {
+    Clock::time_point earliest = Clock::time_point::max();
+    for (size_t level = 0; level < PRIORITY_LEVELS; ++level) {
+        // 단계 안에서는 지연이 같으므로 맨 앞(가장 먼저 들어온) 프레임의 마감 시각이 가장 이릅니다.
+        const auto& queue = queues[level];
+        if (queue.empty()) {
+            continue;
+        }
+        Clock::time_point deadline = queue.front().enqueued + levelDelay[level];
+        if (deadline < earliest) {
+            earliest = deadline;
+        }
+    }
+    return earliest;
+}
+
+bool SendCoalescer::poll(Clock::time_point now) {
+    if (pendingFrames == 0 || NextDeadline() > now) {
+        return false;
+    }
+    flushNow(FlushReason::Deadline);
+    return true;
+}
+
+void SendCoalescer::flush() {
+    if (pendingFrames != 0) {
+        flushNow(FlushReason::Manual);
+    }
+}
+
+void SendCoalescer::flushNow(FlushReason reason) {
+    batch.clear();
+    batch.reserve(pendingFrames);
+    for (size_t level = PRIORITY_LEVELS; level-- > 0;) {
+        for (Pending& pending : queues[level]) {
+            batch.push_back(std::move(pending.frame));
+        }
+        queues[level].clear();
+    }
+
+    size_t frames = pendingFrames;
+    stats.batches++;
+    stats.frames += frames;
+    stats.bytes += pendingBytes;
+    switch (reason) {
+        case FlushReason::Size: stats.flushBySize++; break;
+        case FlushReason::Count: stats.flushByCount++; break;
+        case FlushReason::Deadline: stats.flushByDeadline++; break;
+        case FlushReason::Priority: stats.flushByPriority++; break;
+        case FlushReason::Manual: stats.flushManual++; break;
+    }
+    size_t bucket = 0;
+    while (bucket + 1 < HISTOGRAM_BUCKETS && (static_cast<size_t>(1) << bucket) < frames) {
+        ++bucket;
+    }
+    stats.framesPerBatch[bucket]++;
+
+    pendingBytes = 0;
+    pendingFrames = 0;
+    sink(batch);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+SendCoalescer::Sink SendCoalescer::FdSink(int fd) {
+    return [fd](const Batch& frames) {
+        std::vector<struct iovec> iov;
+        iov.reserve(frames.size());
+        for (const auto& frame : frames) {
+            if (!frame.empty()) {
+                iov.push_back({ const_cast<uint8_t*>(frame.data()), frame.size() });
+            }
+        }
+
+        size_t index = 0;
+        while (index < iov.size()) {
+            int count = static_cast<int>(std::min<size_t>(iov.size() - index, IOV_MAX));
+            ssize_t written = ::writev(fd, iov.data() + index, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "writev");
+            }
+            // 부분 쓰기: 다 쓴 iovec 을 건너뛰고 남은 iovec 의 시작점을 옮깁니다.
+            size_t remaining = static_cast<size_t>(written);
+            while (index < iov.size() && remaining >= iov[index].iov_len) {
+                remaining -= iov[index].iov_len;
+                ++index;
+            }
+            if (remaining > 0) {
+                iov[index].iov_base = static_cast<uint8_t*>(iov[index].iov_base) + remaining;
+                iov[index].iov_len -= remaining;
+            }
+        }
+    };
+}
+#endif
+
+} // namespace streamprotocol
@@ -0,0 +1,296 @@
+#include "streamprotocol/Session.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "streamprotocol/PacketException.h"
+
+#include "Detail.hpp"
+
+namespace streamprotocol {
+
+namespace {
+
+uint64_t randomSessionId() {
+    std::random_device random;
+    uint64_t id = 0;
+    while (id == 0) {
+        id = (static_cast<uint64_t>(random()) << 32) ^ random();
+    }
+    return id;
+}
+
+} // namespace
+
+RetransmitRing::RetransmitRing()
+    : RetransmitRing(Options()) {
+}
+
+RetransmitRing::RetransmitRing(const Options& options)
+    : capacity(options.capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("retransmit capacity must not be 0");
+    }
+    if (options.spillDirectory.empty()) {
+        // 값 초기화하지 않으므로 실제로 쓴 페이지만 상주합니다.
+        memory.reset(new uint8_t[capacity]);
+        storage = memory.get();
+        return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    fd = detail::openSpillFile(options.spillDirectory, "streamprotocol-retransmit");
+    if (::ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    void* mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    storage = static_cast<uint8_t*>(mapping);
+#else
+    throw std::invalid_argument("spilling the retransmit ring is not supported on this platform");
+#endif
+}
+
+RetransmitRing::~RetransmitRing() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (fd >= 0) {
+        ::munmap(storage, capacity);
+        ::close(fd);
+    }
+#endif
+}
+
+bool RetransmitRing::place(size_t size, size_t& offset) const {
+    if (entries.empty()) {
+        offset = 0;
+        return size <= capacity;
+    }
+    size_t head = entries.front().offset;
+    if (tail > head) {
+        // 사용 중인 영역이 [head, tail) 한 덩어리: 뒤에 넣거나, 앞쪽 [0, head) 로 돌아감
+        if (size <= capacity - tail) {
+            offset = tail;
+            return true;
+        }
+        offset = 0;
+        return size <= head;
+    }
+    // 한 번 돌아간 상태: 사용 중인 영역이 [head, capacity) + [0, tail)
+    offset = tail;
+    return size <= head - tail;
+}
+
+void RetransmitRing::popOldest() {
+    usedBytes -= entries.front().size;
+    entries.pop_front();
+    ++oldest;
+}
+
+uint64_t RetransmitRing::push(const uint8_t* frame, size_t size) {
+    if (frame == nullptr || size == 0) {
+        throw std::invalid_argument("frame must not be empty");
+    }
+    uint64_t sequence = NextSequence();
+    if (size > capacity) {
+        // 보관할 수 없는 프레임: 이 순번 이전으로는 이어 보낼 수 없게 됩니다.
+        droppedFrames += entries.size() + 1;
+        while (!entries.empty()) {
+            popOldest();
+        }
+        oldest = sequence + 1;
+        tail = 0;
+        return sequence;
+    }
+
+    size_t offset;
+    while (!place(size, offset)) {
+        popOldest();
+        ++droppedFrames;
+    }
+    std::memcpy(storage + offset, frame, size);
+    entries.push_back(Entry{ offset, size });
+    tail = offset + size;
+    usedBytes += size;
+    return sequence;
+}
+
+void RetransmitRing::release(uint64_t sequence) {
+    while (!entries.empty() && oldest < sequence) {
+        popOldest();
+    }
+}
+
+void RetransmitRing::reset() {
+    entries.clear();
+    oldest = 0;
+    tail = 0;
+    usedBytes = 0;
+}
+
+bool RetransmitRing::forEachFrom(uint64_t from, const std::function<void(const uint8_t*, size_t)>& visit) const {
+    if (from < oldest) {
+        return false;
+    }
+    for (uint64_t i = from - oldest; i < entries.size(); ++i) {
+        const Entry& entry = entries[static_cast<size_t>(i)];
+        visit(storage + entry.offset, entry.size);
+    }
+    return true;
+}
+
+SessionControl SessionControl::Decode(const uint8_t* payload, size_t size) {
+    if (payload == nullptr || size < SIZE) {
+        throw PacketException("Session control payload too short: " + std::to_string(size) + " bytes (min: " +
+                              std::to_string(SIZE) + ")");
+    }
+    SessionControl control;
+    control.kind = payload[0];
+    if (control.kind < HELLO || control.kind > ACK) {
+        throw PacketException("Unknown session control kind: " + std::to_string(control.kind));
+    }
+    control.sessionId = detail::getLE64(payload + 1);
+    control.sequence = detail::getLE64(payload + 9);
+    return control;
+}
+
+namespace {
+
+std::vector<uint8_t> encodeControl(StreamProtocol& protocol, uint8_t kind, uint64_t sessionId, uint64_t sequence) {
+    uint8_t payload[SessionControl::SIZE];
+    payload[0] = kind;
+    detail::putLE64(payload + 1, sessionId);
+    detail::putLE64(payload + 9, sequence);
+    return protocol.toBytes(payload, sizeof(payload), PayloadType::SESSION);
+}
+
+} // namespace
+
+SessionSender::SessionSender(StreamProtocol& protocol)
+    : SessionSender(protocol, Options()) {
+}
+
+SessionSender::SessionSender(StreamProtocol& protocol, const Options& options)
+    : protocol(protocol),
+      ring(RetransmitRing::Options{ options.retransmitBytes, options.spillDirectory }),
+      sessionId(options.sessionId != 0 ? options.sessionId : randomSessionId()) {
+}
+
+std::vector<uint8_t> SessionSender::hello() {
+    resuming = true;
+    return encodeControl(protocol, SessionControl::HELLO, sessionId, ring.NextSequence());
+}
+
+uint64_t SessionSender::record(const uint8_t* frame, size_t size) {
+    uint64_t sequence = ring.push(frame, size);
+    stats.frames++;
+    stats.bytes += size;
+    return sequence;
+}
+
+SessionSender::Event SessionSender::accept(const ParsedPacketView& frame, const Write& write) {
+    if (frame.PayloadType() != PayloadType::SESSION) {
+        return Event::None;
+    }
+    SessionControl control = SessionControl::Decode(frame.Payload(), frame.PayloadSize());
+    if (control.sessionId != sessionId || control.kind == SessionControl::HELLO) {
+        // 이전 세션의 늦은 응답이거나 송신 측이 받을 종류가 아님
+        return Event::None;
+    }
+    if (control.sequence > ring.NextSequence()) {
+        throw PacketException("Peer acknowledged " + std::to_string(control.sequence) + " frames but only " +
+                              std::to_string(ring.NextSequence()) + " were sent");
+    }
+    ring.release(control.sequence);
+    if (control.kind == SessionControl::ACK) {
+        return Event::Acked;
+    }
+
+    stats.resumes++;
+    if (control.sequence < ring.OldestSequence()) {
+        // 상대가 받지 못한 프레임이 이미 링에서 밀려났습니다. Resuming() 은 그대로 두어 쓰기를 막습니다.
+        stats.lost++;
+        return Event::Lost;
+    }
+    if (!write) {
+        throw std::invalid_argument("write must not be empty");
+    }
+    ring.forEachFrom(control.sequence, [&](const uint8_t* data, size_t size) {
+        write(data, size);
+        stats.resentFrames++;
+        stats.resentBytes += size;
+    });
+    resuming = false;
+    return Event::Resumed;
+}
+
+void SessionSender::newSession(uint64_t id) {
+    sessionId = id != 0 ? id : randomSessionId();
+    ring.reset();
+    resuming = false;
+}
+
+SessionReceiver::SessionReceiver(StreamProtocol& protocol)
+    : SessionReceiver(protocol, Options()) {
+}
+
+SessionReceiver::SessionReceiver(StreamProtocol& protocol, const Options& options)
+    : protocol(protocol), options(options) {
+    if (options.ackEvery == 0) {
+        throw std::invalid_argument("ackEvery must be at least 1");
+    }
+}
+
+std::vector<uint8_t> SessionReceiver::control(uint8_t kind) {
+    sinceAck = 0;
+    return encodeControl(protocol, kind, sessionId, received);
+}
+
+bool SessionReceiver::accept(const ParsedPacketView& frame, std::vector<uint8_t>& reply) {
+    reply.clear();
+    if (frame.PayloadType() != PayloadType::SESSION) {
+        if (active) {
+            ++received;
+            if (++sinceAck >= options.ackEvery) {
+                reply = control(SessionControl::ACK);
+            }
+        }
+        return true;
+    }
+
+    SessionControl message = SessionControl::Decode(frame.Payload(), frame.PayloadSize());
+    if (message.kind != SessionControl::HELLO) {
+        return false;
+    }
+    if (!active || message.sessionId != sessionId) {
+        // 처음 보는 세션: 0 부터 받습니다.
+        sessionId = message.sessionId;
+        received = 0;
+        active = true;
+    } else if (message.sequence < received) {
+        throw PacketException("Session " + std::to_string(sessionId) + " resumed at " +
+                              std::to_string(message.sequence) + " but " + std::to_string(received) +
+                              " frames were already received");
+    }
+    reply = control(SessionControl::RESUME);
+    return false;
+}
+
+std::vector<uint8_t> SessionReceiver::ack() {
+    return control(SessionControl::ACK);
+}
+
+} // namespace streamprotocol
@@ -0,0 +1,335 @@
+#include "streamprotocol/ShmChannel.hpp"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace streamprotocol {
+
+/// 공유 메모리 맨 앞에 놓이는 제어 블록입니다. 링 데이터는 한 페이지 뒤에서 시작합니다.
+struct ShmRegionHeader {
+    uint64_t magic;
+    uint32_t layoutVersion;
+    uint32_t reserved;
+    uint64_t capacity;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> dataSeq;     // futex: 새 프레임 공개 시 증가
+    std::atomic<uint32_t> readerWaiting;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> spaceSeq;    // futex: 레코드 해제 시 증가
+    std::atomic<uint32_t> writerWaiting;
+
+    FrameRingControl control;
+};
+
+namespace {
+
+constexpr uint64_t SHM_MAGIC = 0x314D485350525453ull;   // "STRPSHM1"
+constexpr uint32_t SHM_LAYOUT_VERSION = 1;
+constexpr size_t SHM_DATA_OFFSET = 4096;
+
+static_assert(sizeof(ShmRegionHeader) <= SHM_DATA_OFFSET, "ShmRegionHeader must fit in the first page");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock-free");
+
+[[noreturn]] void throwErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+std::string shmName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, int timeoutMs) {
+    struct timespec ts;
+    struct timespec* tsp = nullptr;
+    if (timeoutMs >= 0) {
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+        tsp = &ts;
+    }
+    // 공유 매핑이므로 FUTEX_PRIVATE_FLAG 를 쓰지 않습니다. EAGAIN/EINTR/ETIMEDOUT 은 호출자가 재확인합니다.
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, tsp, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// 남은 대기 시간(ms)을 계산합니다. 음수 timeout 은 무한 대기를 뜻합니다.
+int remainingMs(int timeoutMs, std::chrono::steady_clock::time_point start) {
+    if (timeoutMs < 0) {
+        return -1;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    return elapsed >= timeoutMs ? 0 : static_cast<int>(timeoutMs - elapsed);
+}
+
+} // namespace
+
+ShmFrameChannel::ShmFrameChannel(int fd, bool initialize, size_t capacity, const StreamProtocol& protocol)
+    : fd(fd) {
+    try {
+        if (initialize) {
+            if (capacity < 64 || (capacity & (capacity - 1)) != 0) {
+                throw std::invalid_argument("ShmFrameChannel capacity must be a power of two (>= 64)");
+            }
+            mappingSize = SHM_DATA_OFFSET + capacity;
+            if (ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+                throwErrno("ftruncate");
+            }
+        } else {
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                throwErrno("fstat");
+            }
+            mappingSize = static_cast<size_t>(st.st_size);
+            if (mappingSize < SHM_DATA_OFFSET + 64) {
+                throw PacketException("Shared memory region too small");
+            }
+        }
+
+        void* p = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            throwErrno("mmap");
+        }
+        mapping = static_cast<uint8_t*>(p);
+
+        if (initialize) {
+            // ftruncate 로 새로 늘린 영역은 0 으로 채워져 있으므로 링 데이터는 이미 초기화된 상태입니다.
+            header = new (mapping) ShmRegionHeader();
+            header->layoutVersion = SHM_LAYOUT_VERSION;
+            header->capacity = capacity;
+            std::atomic_thread_fence(std::memory_order_release);
+            reinterpret_cast<std::atomic<uint64_t>*>(&header->magic)->store(SHM_MAGIC, std::memory_order_release);
+        } else {
+            header = reinterpret_cast<ShmRegionHeader*>(mapping);
+            uint64_t magic = reinterpret_cast<std::atomic<uint64_t>*>(&header->magic)->load(std::memory_order_acquire);
+            if (magic != SHM_MAGIC || header->layoutVersion != SHM_LAYOUT_VERSION) {
+                throw PacketException("Not a StreamProtocol shared memory channel");
+            }
+            capacity = static_cast<size_t>(header->capacity);
+            if (SHM_DATA_OFFSET + capacity > mappingSize) {
+                throw PacketException("Shared memory region smaller than its ring capacity");
+            }
+        }
+
+        ring.reset(new SpscFrameRing(&header->control, mapping + SHM_DATA_OFFSET, capacity, protocol));
+    } catch (...) {
+        if (mapping != nullptr) {
+            munmap(mapping, mappingSize);
+        }
+        ::close(fd);
+        throw;
+    }
+}
+
+ShmFrameChannel ShmFrameChannel::create(const std::string& name, size_t capacity, const StreamProtocol& protocol) {
+    int fd = shm_open(shmName(name).c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        throwErrno("shm_open");
+    }
+    return ShmFrameChannel(fd, true, capacity, protocol);
+}
+
+ShmFrameChannel ShmFrameChannel::createAnonymous(size_t capacity, const StreamProtocol& protocol) {
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "streamprotocol", 0));
+    if (fd < 0) {
+        throwErrno("memfd_create");
+    }
+    return ShmFrameChannel(fd, true, capacity, protocol);
+}
+
+ShmFrameChannel ShmFrameChannel::open(const std::string& name, const StreamProtocol& protocol) {
+    int fd = shm_open(shmName(name).c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throwErrno("shm_open");
+    }
+    return ShmFrameChannel(fd, false, 0, protocol);
+}
+
+ShmFrameChannel ShmFrameChannel::fromFd(int fd, const StreamProtocol& protocol) {
+    if (fd < 0) {
+        throw std::invalid_argument("invalid file descriptor");
+    }
+    return ShmFrameChannel(fd, false, 0, protocol);
+}
+
+void ShmFrameChannel::unlink(const std::string& name) {
+    if (shm_unlink(shmName(name).c_str()) != 0 && errno != ENOENT) {
+        throwErrno("shm_unlink");
+    }
+}
+
+ShmFrameChannel::ShmFrameChannel(ShmFrameChannel&& other) noexcept
+    : fd(other.fd), mapping(other.mapping), mappingSize(other.mappingSize), header(other.header), ring(std::move(other.ring)) {
+    other.fd = -1;
+    other.mapping = nullptr;
+    other.header = nullptr;
+}
+
+ShmFrameChannel& ShmFrameChannel::operator=(ShmFrameChannel&& other) noexcept {
+    // 기존 자원은 other 로 넘겨 other 의 소멸자가 정리하게 합니다.
+    std::swap(fd, other.fd);
+    std::swap(mapping, other.mapping);
+    std::swap(mappingSize, other.mappingSize);
+    std::swap(header, other.header);
+    std::swap(ring, other.ring);
+    return *this;
+}
+
+ShmFrameChannel::~ShmFrameChannel() {
+    ring.reset();
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void ShmFrameChannel::wakeReader() {
+    header->dataSeq.fetch_add(1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->readerWaiting.load(std::memory_order_relaxed) != 0) {
+        futexWake(header->dataSeq);
+    }
+}
+
+void ShmFrameChannel::wakeWriter() {
+    header->spaceSeq.fetch_add(1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->writerWaiting.load(std::memory_order_relaxed) != 0) {
+        futexWake(header->spaceSeq);
+    }
+}
+
+FrameSlot ShmFrameChannel::reserve(size_t payloadSize, int timeoutMs) {
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        FrameSlot slot = ring->tryReserve(payloadSize);
+        if (slot || timeoutMs == 0) {
+            return slot;
+        }
+
+        uint32_t seq = header->spaceSeq.load(std::memory_order_acquire);
+        header->writerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        slot = ring->tryReserve(payloadSize);
+        if (!slot) {
+            futexWait(header->spaceSeq, seq, remainingMs(timeoutMs, start));
+        }
+        header->writerWaiting.store(0, std::memory_order_relaxed);
+        if (slot) {
+            return slot;
+        }
+        if (remainingMs(timeoutMs, start) == 0) {
+            return ring->tryReserve(payloadSize);
+        }
+    }
+}
+
+void ShmFrameChannel::commit(FrameSlot& slot, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) {
+    try {
+        ring->commit(slot, payloadType, fragFlag, userValue);
+    } catch (...) {
+        // 링이 레코드를 취소했으므로 읽는 쪽이 건너뛸 수 있게 깨웁니다.
+        wakeReader();
+        throw;
+    }
+    wakeReader();
+}
+
+void ShmFrameChannel::commitFrame(FrameSlot& slot) {
+    ring->commitFrame(slot);
+    wakeReader();
+}
+
+void ShmFrameChannel::cancel(FrameSlot& slot) {
+    if (!slot) {
+        return;
+    }
+    ring->cancel(slot);
+    wakeReader();
+}
+
+bool ShmFrameChannel::write(const uint8_t* payload, size_t size, uint8_t payloadType,
+                            uint8_t fragFlag, uint16_t userValue, int timeoutMs) {
+    if (payload == nullptr && size != 0) {
+        throw std::invalid_argument("payload must not be null");
+    }
+    FrameSlot slot = reserve(size, timeoutMs);
+    if (!slot) {
+        return false;
+    }
+    if (size != 0) {
+        std::copy(payload, payload + size, slot.Payload());
+    }
+    commit(slot, payloadType, fragFlag, userValue);
+    return true;
+}
+
+// 취소된 레코드나 패딩을 건너뛰면 tail 이 움직이므로, 공간을 기다리는 쓰는 쪽을 깨웁니다.
+bool ShmFrameChannel::tryRead(ParsedPacketView& view) {
+    uint64_t tail = header->control.tail.load(std::memory_order_relaxed);
+    bool ready = ring->tryRead(view);
+    if (header->control.tail.load(std::memory_order_relaxed) != tail) {
+        wakeWriter();
+    }
+    return ready;
+}
+
+bool ShmFrameChannel::read(ParsedPacketView& view, int timeoutMs) {
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        if (tryRead(view)) {
+            return true;
+        }
+        if (timeoutMs == 0) {
+            return false;
+        }
+
+        uint32_t seq = header->dataSeq.load(std::memory_order_acquire);
+        header->readerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ready = false;
+        try {
+            ready = tryRead(view);
+        } catch (...) {
+            header->readerWaiting.store(0, std::memory_order_relaxed);
+            throw;
+        }
+        if (!ready) {
+            futexWait(header->dataSeq, seq, remainingMs(timeoutMs, start));
+        }
+        header->readerWaiting.store(0, std::memory_order_relaxed);
+        if (ready) {
+            return true;
+        }
+        if (remainingMs(timeoutMs, start) == 0) {
+            return tryRead(view);
+        }
+    }
+}
+
+void ShmFrameChannel::release() {
+    ring->release();
+    wakeWriter();
+}
+
+} // namespace streamprotocol
+
+#endif // __linux__
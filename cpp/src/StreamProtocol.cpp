@@ -1,47 +1,126 @@
 #include "streamprotocol/StreamProtocol.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "streamprotocol/Crc32.hpp"
+#include "streamprotocol/FrameBuffer.hpp"
+
 namespace streamprotocol {
 
-uint32_t StreamProtocol::computeCRC32(const uint8_t* data, size_t length) {
-    uint32_t crc = 0xFFFFFFFF;
-    for (size_t i = 0; i < length; ++i) {
-        crc ^= data[i];
-        for (int j = 0; j < 8; ++j) {
-            uint32_t mask = 0 - (crc & 1);
-            crc = (crc >> 1) ^ (0xEDB88320 & mask);
-        }
+namespace {
+
+// Payloads are copied into a growing vector in chunks of this size
+constexpr size_t APPEND_CHUNK = 16u * 1024u;
+
+// Grows out one chunk at a time and copies src into it through Crc32::copyUpdate, so each payload byte is read once.
+// The zero-fill from resize() only touches the chunk about to be overwritten, which is still in L1.
+void appendWithCRC(std::vector<uint8_t>& out, Crc32& crc, const uint8_t* src, size_t size) {
+    for (size_t offset = 0; offset < size; offset += APPEND_CHUNK) {
+        size_t n = std::min(APPEND_CHUNK, size - offset);
+        size_t end = out.size();
+        out.resize(end + n);
+        crc.copyUpdate(out.data() + end, src + offset, n);
+    }
+}
+
+// Reads the little-endian CRC trailer of a frame
+uint32_t readTrailer(const uint8_t* packet, size_t packetLength) {
+    uint32_t value = 0;
+    size_t crcOffset = packetLength - sizeof(uint32_t);
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        value |= (static_cast<uint32_t>(packet[crcOffset + i]) << (i * 8));
     }
-    return ~crc;
+    return value;
+}
+
+} // namespace
+
+uint32_t StreamProtocol::computeCRC32(const uint8_t* data, size_t length, uint8_t version) const {
+    return Crc32::compute(data, length, Crc32::ForVersion(version));
 }
 
-std::vector<uint8_t> StreamProtocol::buildPacket(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) {
-    if (data == nullptr) {
+std::vector<uint8_t> StreamProtocol::buildPacket(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
+    if (data == nullptr && size != 0) {
         throw std::invalid_argument("payload must not be null");
     }
 
+    // Calculate total packet length (Header + Payload + CRC (4 bytes))
+    uint64_t totalPacketLength64 = HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t);
+    if (totalPacketLength64 > MAX_PACKET_LENGTH) {
+        throw PayloadTooLargeException(totalPacketLength64, MAX_PACKET_LENGTH);
+    }
+
+    // Reserve once, then copy the payload and fold it into the CRC in the same pass
+    std::vector<uint8_t> packet;
+    packet.reserve(static_cast<size_t>(totalPacketLength64));
+    uint8_t header[HEADER_SIZE];
+    encodeHeader(header, size, payloadType, fragFlag, userValue);
+    packet.insert(packet.end(), header, header + HEADER_SIZE);
+
+    Crc32 crc(Crc32::ForVersion(protocolVersion));
+    crc.update(header, HEADER_SIZE);
+    appendWithCRC(packet, crc, data, size);
+
+    uint32_t value = crc.value();
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        packet.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFFu));
+    }
+
+    return packet;
+}
+
+size_t StreamProtocol::encodeInto(const uint8_t* data, size_t size, uint8_t* out, size_t capacity, uint8_t payloadType,
+                                  uint8_t fragFlag, uint16_t userValue) const {
+    if ((data == nullptr && size != 0) || out == nullptr) {
+        throw std::invalid_argument("payload and output must not be null");
+    }
+
+    // Check capacity before the header is written so a short buffer is never touched
+    if (capacity < HEADER_SIZE + sizeof(uint32_t) || capacity - HEADER_SIZE - sizeof(uint32_t) < size) {
+        throw PayloadTooLargeException(size + HEADER_SIZE + sizeof(uint32_t), capacity);
+    }
+    encodeHeader(out, size, payloadType, fragFlag, userValue);
+    size_t totalPacketLength = HEADER_SIZE + size + sizeof(uint32_t);
+
+    // Copy the payload and fold it into the CRC in the same pass (each payload byte is read once)
+    Crc32 crc(Crc32::ForVersion(protocolVersion));
+    crc.update(out, HEADER_SIZE);
+    crc.copyUpdate(out + HEADER_SIZE, data, size);
+    uint32_t value = crc.value();
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        out[HEADER_SIZE + size + i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFFu);
+    }
+
+    return totalPacketLength;
+}
+
+void StreamProtocol::encodeHeader(uint8_t* header, size_t payloadSize, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
+    if (header == nullptr) {
+        throw std::invalid_argument("header must not be null");
+    }
+
     // Validate fragment flag
     if (fragFlag != FRAGED && fragFlag != UNFRAGED) {
         throw std::invalid_argument("Invalid fragment flag");
     }
 
     // Validate payload type (4-bit: 0-15)
-    uint8_t pt = payloadType & 0xFF;
-    if (pt > 0x0F) {
+    if (payloadType > 0x0F) {
         throw std::invalid_argument("payloadType must be 4 bits (0-15)");
     }
 
-    // Calculate total packet length (Header + Payload + CRC (4 bytes))
-    uint64_t totalPacketLength64 = HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t);
-    if (totalPacketLength64 > MAX_PACKET_LENGTH) {
-        throw PayloadTooLargeException(totalPacketLength64, MAX_PACKET_LENGTH);
-    }
-    size_t totalPacketLength = static_cast<size_t>(totalPacketLength64);
-
     // Validate userField (10-bit: 0-1023)
     if (userValue > 0x3FF) {
         throw std::invalid_argument("userField must be 10-bit (0-1023)");
     }
 
+    uint64_t totalPacketLength64 = HEADER_SIZE + static_cast<uint64_t>(payloadSize) + sizeof(uint32_t);
+    if (payloadSize > MAX_PAYLOAD_LENGTH || totalPacketLength64 > MAX_PACKET_LENGTH) {
+        throw PayloadTooLargeException(totalPacketLength64, MAX_PACKET_LENGTH);
+    }
+
     // Build 64-bit header value (little-endian)
     uint64_t headerValue = 0;
     headerValue |= (static_cast<uint64_t>(protocolVersion) & 0x0F) << 0;               // 4 bits
@@ -50,30 +129,35 @@ std::vector<uint8_t> StreamProtocol::buildPacket(const uint8_t* data, size_t siz
     headerValue |= (static_cast<uint64_t>(payloadType) & 0x0Fu) << 50;                // 4 bits
     headerValue |= (static_cast<uint64_t>(userValue) & 0x3FFu) << 54;                 // 10 bits
 
-    std::vector<uint8_t> packet;
-    packet.reserve(totalPacketLength);
+    // Write header (8 bytes, little-endian)
+    for (size_t i = 0; i < HEADER_SIZE; ++i) {
+        header[i] = static_cast<uint8_t>((headerValue >> (i * 8)) & 0xFFu);
+    }
+}
 
-    // Insert header (8 bytes, little-endian)
-    for (int i = 0; i < static_cast<int>(HEADER_SIZE); ++i) {
-        packet.push_back(static_cast<uint8_t>((headerValue >> (i * 8)) & 0xFFu));
+size_t StreamProtocol::sealFrame(uint8_t* frame, size_t payloadSize, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
+    if (frame == nullptr) {
+        throw std::invalid_argument("frame must not be null");
     }
 
-    // Insert payload data
-    packet.insert(packet.end(), data, data + size);
+    encodeHeader(frame, payloadSize, payloadType, fragFlag, userValue);
+    size_t totalPacketLength = HEADER_SIZE + payloadSize + sizeof(uint32_t);
 
-    // Calculate CRC for header + payload
-    uint32_t crc = computeCRC32(packet.data(), packet.size());
-    const uint8_t* crcBytes = reinterpret_cast<const uint8_t*>(&crc);
-    packet.insert(packet.end(), crcBytes, crcBytes + sizeof(uint32_t));
+    // Calculate CRC for header + payload and append it (little-endian)
+    size_t crcOffset = totalPacketLength - sizeof(uint32_t);
+    uint32_t crc = computeCRC32(frame, crcOffset, protocolVersion);
+    for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+        frame[crcOffset + i] = static_cast<uint8_t>((crc >> (i * 8)) & 0xFFu);
+    }
 
-    return packet;
+    return totalPacketLength;
 }
 
-std::vector<uint8_t> StreamProtocol::toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue) {
+std::vector<uint8_t> StreamProtocol::toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue) const {
     return buildPacket(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), 0x01u, fragFlag, userValue);
 }
 
-std::vector<uint8_t> StreamProtocol::toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue, size_t bufferSize) {
+std::vector<uint8_t> StreamProtocol::toBytes(const std::string& payload, uint8_t fragFlag, uint16_t userValue, size_t bufferSize) const {
     if (bufferSize < HEADER_SIZE + sizeof(uint32_t)) {
         throw BufferTooSmallException(bufferSize);
     }
@@ -86,56 +170,119 @@ std::vector<uint8_t> StreamProtocol::toBytes(const std::string& payload, uint8_t
     return buildPacket(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), 0x01u, fragFlag, userValue);
 }
 
+std::vector<uint8_t> StreamProtocol::toBytes(const uint8_t* data, size_t size, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
+    return buildPacket(data, size, payloadType, fragFlag, userValue);
+}
+
+std::vector<uint8_t> StreamProtocol::toBytes(const std::vector<uint8_t>& payload, uint8_t fragFlag, uint16_t userValue) const {
+    return buildPacket(payload.data(), payload.size(), 0x00u, fragFlag, userValue);
+}
+
+std::vector<uint8_t> StreamProtocol::toBytes(std::vector<uint8_t>&& payload, uint8_t fragFlag, uint16_t userValue) const {
+    size_t size = payload.size();
+    if (size > MAX_PAYLOAD_LENGTH) {
+        throw PayloadTooLargeException(HEADER_SIZE + static_cast<uint64_t>(size) + sizeof(uint32_t), MAX_PACKET_LENGTH);
+    }
+
+    // Grow in place and slide the payload behind the header slot
+    std::vector<uint8_t> packet(std::move(payload));
+    packet.resize(size + FRAME_OVERHEAD);
+    if (size != 0) {
+        std::memmove(packet.data() + HEADER_SIZE, packet.data(), size);
+    }
+    sealFrame(packet.data(), size, 0x00u, fragFlag, userValue);
+
+    return packet;
+}
+
+std::vector<uint8_t> StreamProtocol::toBytes(FrameBuffer&& buffer, uint8_t payloadType, uint8_t fragFlag, uint16_t userValue) const {
+    sealFrame(buffer.storage.data(), buffer.PayloadSize(), payloadType, fragFlag, userValue);
+
+    std::vector<uint8_t> packet(std::move(buffer.storage));
+    buffer.storage.assign(FRAME_OVERHEAD, 0);
+    return packet;
+}
+
 ParsedPacket StreamProtocol::parsePacket(const std::vector<uint8_t>& packetBytes) {
-    if (packetBytes.size() < HEADER_SIZE + sizeof(uint32_t)) {
-        throw BufferTooSmallException(packetBytes.size());
+    ParsedPacketView frame = checkFrame(packetBytes.data(), packetBytes.size());
+
+    // Copy the payload out and fold it into the CRC in the same pass, then compare against the trailer
+    Crc32 crc(Crc32::ForVersion(frame.ProtocolVersion()));
+    crc.update(packetBytes.data(), HEADER_SIZE);
+    std::vector<uint8_t> payload;
+    payload.reserve(frame.PayloadSize());
+    appendWithCRC(payload, crc, frame.Payload(), frame.PayloadSize());
+
+    uint32_t receivedCRC = readTrailer(packetBytes.data(), frame.PacketLength());
+    if (crc.value() != receivedCRC) {
+        throw InvalidCRCException(receivedCRC, crc.value());
+    }
+
+    return ParsedPacket(frame.ProtocolVersion(), frame.PacketLength(), frame.FragmentFlag(), frame.PayloadType(),
+                        frame.UserField(), std::move(payload));
+}
+
+FrameHeader StreamProtocol::decodeHeader(const uint8_t* headerBytes) const {
+    if (headerBytes == nullptr) {
+        throw std::invalid_argument("header must not be null");
     }
 
     // Read 64-bit header (little-endian)
     uint64_t headerValue = 0;
     for (size_t i = 0; i < HEADER_SIZE; ++i) {
-        headerValue |= (static_cast<uint64_t>(packetBytes[i]) << (i * 8));
+        headerValue |= (static_cast<uint64_t>(headerBytes[i]) << (i * 8));
     }
 
-    uint8_t protoVersion = static_cast<uint8_t>((headerValue >> 0) & 0x0F);
-    uint64_t packetLength64 = (headerValue >> 4) & 0x1FFFFFFFFFFFull;
-    uint8_t fragmentFlag = static_cast<uint8_t>((headerValue >> 49) & 0x01);
-    uint8_t payloadType = static_cast<uint8_t>((headerValue >> 50) & 0x0F);
-    uint16_t userField = static_cast<uint16_t>((headerValue >> 54) & 0x3FF);
+    FrameHeader header;
+    header.protocolVersion = static_cast<uint8_t>((headerValue >> 0) & 0x0F);
+    header.packetLength = (headerValue >> 4) & 0x1FFFFFFFFFFFull;
+    header.fragmentFlag = static_cast<uint8_t>((headerValue >> 49) & 0x01);
+    header.payloadType = static_cast<uint8_t>((headerValue >> 50) & 0x0F);
+    header.userField = static_cast<uint16_t>((headerValue >> 54) & 0x3FF);
 
-    if (packetLength64 < HEADER_SIZE + sizeof(uint32_t)) {
-        throw BufferTooSmallException(packetLength64);
+    if (header.packetLength < HEADER_SIZE + sizeof(uint32_t)) {
+        throw BufferTooSmallException(header.packetLength);
     }
 
-    if (packetLength64 > MAX_PACKET_LENGTH) {
-        throw PayloadTooLargeException(packetLength64, MAX_PACKET_LENGTH);
+    if (header.packetLength > MAX_PACKET_LENGTH) {
+        throw PayloadTooLargeException(header.packetLength, MAX_PACKET_LENGTH);
     }
 
-    size_t packetLength = static_cast<size_t>(packetLength64);
+    return header;
+}
 
-    // Validate packet length against actual buffer size
-    if (packetBytes.size() != packetLength) {
-        throw PacketSizeMismatch(packetBytes.size(), packetLength);
+ParsedPacketView StreamProtocol::checkFrame(const uint8_t* packet, size_t size) const {
+    if (packet == nullptr || size < HEADER_SIZE + sizeof(uint32_t)) {
+        throw BufferTooSmallException(packet == nullptr ? 0 : size);
     }
 
-    // Extract received CRC (last 4 bytes)
-    uint32_t receivedCRC = 0;
-    size_t crcOffset = packetLength - sizeof(uint32_t);
-    for (int i = 0; i < 4; ++i) {
-        receivedCRC |= (static_cast<uint32_t>(packetBytes[crcOffset + i]) << (i * 8));
+    FrameHeader header = decodeHeader(packet);
+    size_t packetLength = static_cast<size_t>(header.packetLength);
+
+    // Validate packet length against actual buffer size
+    if (size != packetLength) {
+        throw PacketSizeMismatch(size, packetLength);
     }
 
-    // Compute CRC for header + payload (excluding CRC itself)
-    uint32_t computedCRC = computeCRC32(packetBytes.data(), packetLength - sizeof(uint32_t));
+    return ParsedPacketView(header.protocolVersion, packetLength, header.fragmentFlag, header.payloadType, header.userField,
+                            packet + HEADER_SIZE, packetLength - HEADER_SIZE - sizeof(uint32_t));
+}
+
+ParsedPacketView StreamProtocol::parsePacketView(const uint8_t* packet, size_t size) const {
+    ParsedPacketView frame = checkFrame(packet, size);
+
+    // Compute CRC for header + payload (excluding CRC itself); the algorithm follows the header's version
+    uint32_t receivedCRC = readTrailer(packet, frame.PacketLength());
+    uint32_t computedCRC = computeCRC32(packet, frame.PacketLength() - sizeof(uint32_t), frame.ProtocolVersion());
     if (computedCRC != receivedCRC) {
         throw InvalidCRCException(receivedCRC, computedCRC);
     }
 
-    // Extract payload
-    std::vector<uint8_t> payload(packetBytes.begin() + HEADER_SIZE,
-                                 packetBytes.begin() + packetLength - sizeof(uint32_t));
+    return frame;
+}
 
-    return ParsedPacket(protoVersion, packetLength, fragmentFlag, payloadType, userField, std::move(payload));
+uint8_t StreamProtocol::ProtocolVersion() const {
+    return protocolVersion;
 }
 
 void StreamProtocol::SetProtocolVersion(uint8_t version) {
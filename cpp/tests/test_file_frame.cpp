@@ -0,0 +1,220 @@
+// FileFrameSender 루프백 테스트입니다. (Linux)
+// sendfile 경로와 pread/write 대체 경로(useSendfile = false)로 파일 영역을 보내고, Unix 소켓 쌍, TCP 루프백,
+// 파이프(소켓이 아닌 fd) 각각에서 받은 바이트가 toBytes() 로 만든 같은 프레임과 바이트 단위로 같은지 확인합니다.
+// 실패한 경우를 모두 출력하고, 하나라도 실패하면 1 로 끝납니다.
+//
+//   g++ -std=c++17 -Iinclude tests/test_file_frame.cpp src/*.cpp -o test_file_frame -pthread && ./test_file_frame
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "streamprotocol/FileFrame.hpp"
+#include "streamprotocol/PayloadType.hpp"
+#include "streamprotocol/StreamProtocol.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+enum class Transport { SocketPair, Tcp, Pipe };
+
+const char* transportName(Transport transport) {
+    switch (transport) {
+    case Transport::SocketPair:
+        return "socketpair";
+    case Transport::Tcp:
+        return "tcp";
+    default:
+        return "pipe";
+    }
+}
+
+[[noreturn]] void throwErrno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// 파일 크기가 페이지 배수가 아니도록 잡아 mmap 앞뒤 여백 처리도 함께 확인합니다.
+int createFile(std::vector<uint8_t>& content) {
+    char path[] = "/tmp/test_file_frame.XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0) {
+        throwErrno("mkstemp");
+    }
+    ::unlink(path);
+    content.resize(300001);
+    uint32_t state = 0x12345678u;
+    for (uint8_t& byte : content) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+    if (::write(fd, content.data(), content.size()) != static_cast<ssize_t>(content.size())) {
+        throwErrno("write test file");
+    }
+    return fd;
+}
+
+/// [0] 은 송신, [1] 은 수신 쪽입니다.
+void connectPair(Transport transport, int fds[2]) {
+    if (transport == Transport::SocketPair) {
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+            throwErrno("socketpair");
+        }
+        return;
+    }
+    if (transport == Transport::Pipe) {
+        int ends[2];
+        if (::pipe2(ends, O_CLOEXEC) != 0) {
+            throwErrno("pipe2");
+        }
+        fds[0] = ends[1];
+        fds[1] = ends[0];
+        return;
+    }
+
+    int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        throwErrno("socket");
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 1) != 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        int error = errno;
+        ::close(listener);
+        throw std::system_error(error, std::generic_category(), "bind/listen loopback");
+    }
+    fds[0] = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fds[0] < 0 || ::connect(fds[0], reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        int error = errno;
+        ::close(listener);
+        throw std::system_error(error, std::generic_category(), "connect loopback");
+    }
+    fds[1] = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+    ::close(listener);
+    if (fds[1] < 0) {
+        throwErrno("accept4");
+    }
+}
+
+/// 송신 쪽이 닫힐 때까지 받은 바이트를 모두 모읍니다.
+void readToEnd(int fd, std::vector<uint8_t>& received) {
+    uint8_t chunk[64 * 1024];
+    for (;;) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;
+        }
+        received.insert(received.end(), chunk, chunk + n);
+    }
+}
+
+/// 영역 하나를 보내고 받은 바이트를 기대 프레임과 비교합니다. 다르면 이유를 돌려주고, 같으면 빈 문자열입니다.
+std::string runCase(const StreamProtocol& protocol, Transport transport, bool useSendfile, int fileFd,
+                    const std::vector<uint8_t>& content, uint64_t offset, uint64_t length) {
+    std::vector<uint8_t> expected =
+        protocol.toBytes(content.data() + offset, static_cast<size_t>(length), PayloadType::BINARY);
+
+    int fds[2];
+    connectPair(transport, fds);
+    std::vector<uint8_t> received;
+    std::thread receiver(readToEnd, fds[1], std::ref(received));
+
+    std::string failure;
+    try {
+        FileFrameSender sender(protocol, FileFrameSender::DEFAULT_MAP_WINDOW, useSendfile);
+        uint64_t sent = sender.send(fds[0], fileFd, offset, length, PayloadType::BINARY);
+        if (sent != expected.size()) {
+            failure = "send() returned " + std::to_string(sent) + ", expected " + std::to_string(expected.size());
+        }
+    } catch (const std::exception& e) {
+        failure = std::string("send() threw: ") + e.what();
+    }
+    ::close(fds[0]);
+    receiver.join();
+    ::close(fds[1]);
+
+    if (failure.empty() && received != expected) {
+        size_t at = 0;
+        while (at < received.size() && at < expected.size() && received[at] == expected[at]) {
+            ++at;
+        }
+        failure = "received " + std::to_string(received.size()) + " bytes, expected " + std::to_string(expected.size()) +
+                  ", first difference at byte " + std::to_string(at);
+    }
+    if (failure.empty()) {
+        // 수신 측 검증 경로도 통과하는지 확인합니다.
+        try {
+            protocol.parsePacketView(received.data(), received.size());
+        } catch (const std::exception& e) {
+            failure = std::string("parsePacketView() threw: ") + e.what();
+        }
+    }
+    return failure;
+}
+
+} // namespace
+
+int main() {
+    try {
+        std::vector<uint8_t> content;
+        int fileFd = createFile(content);
+
+        struct Region {
+            uint64_t offset;
+            uint64_t length;
+        };
+        const Region regions[] = {
+            { 0, content.size() },          // 파일 전체 (64KiB pread 버퍼와 파이프 버퍼보다 큼)
+            { 4097, 100000 },               // 페이지 경계가 아닌 시작
+            { content.size() - 1, 1 },      // 마지막 바이트
+            { 1234, 0 },                    // 빈 페이로드
+        };
+
+        size_t total = 0;
+        size_t failed = 0;
+        for (uint8_t version : { StreamProtocol::DEFAULT_PROTOCOL_VERSION, StreamProtocol::CRC32C_PROTOCOL_VERSION }) {
+            StreamProtocol protocol;
+            protocol.SetProtocolVersion(version);
+            for (Transport transport : { Transport::SocketPair, Transport::Tcp, Transport::Pipe }) {
+                for (bool useSendfile : { true, false }) {
+                    for (const Region& region : regions) {
+                        ++total;
+                        std::string failure =
+                            runCase(protocol, transport, useSendfile, fileFd, content, region.offset, region.length);
+                        if (!failure.empty()) {
+                            ++failed;
+                            std::printf("FAIL v%u %s/%s offset=%llu length=%llu: %s\n", static_cast<unsigned>(version),
+                                        transportName(transport), useSendfile ? "sendfile" : "copy",
+                                        static_cast<unsigned long long>(region.offset),
+                                        static_cast<unsigned long long>(region.length), failure.c_str());
+                        }
+                    }
+                }
+            }
+        }
+        ::close(fileFd);
+
+        std::printf("%zu/%zu cases passed\n", total - failed, total);
+        return failed == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "test_file_frame: %s\n", e.what());
+        return 1;
+    }
+}
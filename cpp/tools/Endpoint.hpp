@@ -0,0 +1,195 @@
+#pragma once
+
+// 도구 공용: "tcp:HOST:PORT", "tcp:PORT", "unix:PATH" 형식의 주소로 소켓을 엽니다. (POSIX)
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace streamprotocol {
+namespace tools {
+
+struct Endpoint {
+    bool unixSocket = false;
+    std::string host;       // tcp: 비어 있으면 listen 시 모든 주소, connect 시 127.0.0.1
+    std::string port;
+    std::string path;       // unix
+};
+
+inline Endpoint parseEndpoint(const std::string& spec) {
+    Endpoint endpoint;
+    if (spec.compare(0, 5, "unix:") == 0) {
+        endpoint.unixSocket = true;
+        endpoint.path = spec.substr(5);
+        if (endpoint.path.empty() || endpoint.path.size() >= sizeof(sockaddr_un::sun_path)) {
+            throw std::invalid_argument("invalid unix socket path: " + spec);
+        }
+        return endpoint;
+    }
+    if (spec.compare(0, 4, "tcp:") == 0) {
+        std::string rest = spec.substr(4);
+        size_t colon = rest.rfind(':');
+        if (colon == std::string::npos) {
+            endpoint.port = rest;
+        } else {
+            endpoint.host = rest.substr(0, colon);
+            endpoint.port = rest.substr(colon + 1);
+        }
+        if (endpoint.port.empty()) {
+            throw std::invalid_argument("missing tcp port: " + spec);
+        }
+        return endpoint;
+    }
+    throw std::invalid_argument("endpoint must be tcp:[HOST:]PORT or unix:PATH, got: " + spec);
+}
+
+[[noreturn]] inline void throwErrno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+inline void setNoDelay(int fd, const Endpoint& endpoint) {
+    if (!endpoint.unixSocket) {
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+}
+
+/// 리슨 소켓을 엽니다. tcp 포트가 0 이면 임시 포트를 받으며, boundPort() 로 확인할 수 있습니다.
+inline int listenOn(const Endpoint& endpoint, int backlog = 16) {
+    int listener;
+    if (endpoint.unixSocket) {
+        listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            throwErrno("socket");
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, endpoint.path.c_str(), sizeof(address.sun_path) - 1);
+        ::unlink(endpoint.path.c_str());
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            throwErrno("bind " + endpoint.path);
+        }
+    } else {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* result = nullptr;
+        int rc = ::getaddrinfo(endpoint.host.empty() ? nullptr : endpoint.host.c_str(), endpoint.port.c_str(), &hints, &result);
+        if (rc != 0) {
+            throw std::runtime_error(std::string("getaddrinfo: ") + ::gai_strerror(rc));
+        }
+        listener = ::socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        if (listener < 0) {
+            ::freeaddrinfo(result);
+            throwErrno("socket");
+        }
+        int one = 1;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (::bind(listener, result->ai_addr, result->ai_addrlen) != 0) {
+            ::freeaddrinfo(result);
+            throwErrno("bind port " + endpoint.port);
+        }
+        ::freeaddrinfo(result);
+    }
+    if (::listen(listener, backlog) != 0) {
+        throwErrno("listen");
+    }
+    return listener;
+}
+
+inline std::string boundPort(int listener) {
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        throwErrno("getsockname");
+    }
+    uint16_t port = address.ss_family == AF_INET6 ? reinterpret_cast<sockaddr_in6*>(&address)->sin6_port
+                                                  : reinterpret_cast<sockaddr_in*>(&address)->sin_port;
+    return std::to_string(ntohs(port));
+}
+
+inline int acceptFrom(int listener, const Endpoint& endpoint) {
+    int fd;
+    do {
+        fd = ::accept(listener, nullptr, nullptr);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        throwErrno("accept");
+    }
+    setNoDelay(fd, endpoint);
+    return fd;
+}
+
+/// 연결 하나를 받을 때까지 기다린 뒤 리슨 소켓을 닫고 연결 fd 를 반환합니다.
+inline int acceptOne(const Endpoint& endpoint) {
+    int listener = listenOn(endpoint, 1);
+    int fd = -1;
+    try {
+        fd = acceptFrom(listener, endpoint);
+    } catch (...) {
+        ::close(listener);
+        throw;
+    }
+    ::close(listener);
+    if (endpoint.unixSocket) {
+        ::unlink(endpoint.path.c_str());
+    }
+    return fd;
+}
+
+inline int connectTo(const Endpoint& endpoint) {
+    int fd;
+    if (endpoint.unixSocket) {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            throwErrno("socket");
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, endpoint.path.c_str(), sizeof(address.sun_path) - 1);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            int saved = errno;
+            ::close(fd);
+            errno = saved;
+            throwErrno("connect " + endpoint.path);
+        }
+        return fd;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    int rc = ::getaddrinfo(endpoint.host.empty() ? "127.0.0.1" : endpoint.host.c_str(), endpoint.port.c_str(), &hints, &result);
+    if (rc != 0) {
+        throw std::runtime_error(std::string("getaddrinfo: ") + ::gai_strerror(rc));
+    }
+    fd = ::socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (fd < 0) {
+        ::freeaddrinfo(result);
+        throwErrno("socket");
+    }
+    if (::connect(fd, result->ai_addr, result->ai_addrlen) != 0) {
+        int saved = errno;
+        ::freeaddrinfo(result);
+        ::close(fd);
+        errno = saved;
+        throwErrno("connect port " + endpoint.port);
+    }
+    ::freeaddrinfo(result);
+    setNoDelay(fd, endpoint);
+    return fd;
+}
+
+} // namespace tools
+} // namespace streamprotocol
@@ -0,0 +1,163 @@
+// 소켓/파이프로 들어오는 StreamProtocol 트래픽을 타임스탬프와 함께 캡처 파일에 기록합니다.
+//
+//   sp_capture -o traffic.spcap --listen tcp:9000
+//   sp_capture -o traffic.spcap --connect unix:/tmp/feed.sock
+//   producer | sp_capture -o traffic.spcap
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Endpoint.hpp"
+#include "streamprotocol/Capture.hpp"
+#include "streamprotocol/Crc32.hpp"
+#include "streamprotocol/StreamProtocol.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: sp_capture -o FILE [--listen ENDPOINT | --connect ENDPOINT] [--max-frame BYTES] [--count N]\n"
+                 "  ENDPOINT: tcp:[HOST:]PORT | unix:PATH   (생략 시 표준 입력)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string output;
+    std::string listenSpec;
+    std::string connectSpec;
+    uint64_t maxFrame = 64ull << 20;
+    uint64_t maxCount = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "--listen" && hasValue) {
+            listenSpec = argv[++i];
+        } else if (arg == "--connect" && hasValue) {
+            connectSpec = argv[++i];
+        } else if (arg == "--max-frame" && hasValue) {
+            maxFrame = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--count" && hasValue) {
+            maxCount = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (output.empty() || (!listenSpec.empty() && !connectSpec.empty())) {
+        usage();
+        return 2;
+    }
+
+    try {
+        int fd = STDIN_FILENO;
+        if (!listenSpec.empty()) {
+            fd = tools::acceptOne(tools::parseEndpoint(listenSpec));
+        } else if (!connectSpec.empty()) {
+            fd = tools::connectTo(tools::parseEndpoint(connectSpec));
+        }
+
+        std::ofstream file(output, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "cannot open " << output << "\n";
+            return 1;
+        }
+        CaptureWriter writer(file);
+        StreamProtocol protocol;
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start;
+        bool started = false;
+        std::vector<uint8_t> buffer;
+        size_t used = 0;
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t badCrc = 0;
+
+        buffer.resize(256 * 1024);
+        for (;;) {
+            if (used == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+            ssize_t got = ::read(fd, buffer.data() + used, buffer.size() - used);
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                tools::throwErrno("read");
+            }
+            if (got == 0) {
+                break;
+            }
+            Clock::time_point now = Clock::now();
+            if (!started) {
+                start = now;
+                started = true;
+            }
+            used += static_cast<size_t>(got);
+
+            // 버퍼 안의 완성된 프레임을 모두 기록합니다. 헤더가 잘못되면 스트림 경계를 알 수 없으므로 멈춥니다.
+            size_t offset = 0;
+            while (used - offset >= StreamProtocol::HEADER_SIZE) {
+                FrameHeader header = protocol.decodeHeader(buffer.data() + offset);
+                if (header.packetLength > maxFrame) {
+                    throw PayloadTooLargeException(header.packetLength, maxFrame);
+                }
+                size_t length = static_cast<size_t>(header.packetLength);
+                if (used - offset < length) {
+                    if (length > buffer.size()) {
+                        buffer.resize(length);
+                    }
+                    break;
+                }
+
+                const uint8_t* frame = buffer.data() + offset;
+                uint32_t received = 0;
+                for (size_t b = 0; b < sizeof(uint32_t); ++b) {
+                    received |= static_cast<uint32_t>(frame[length - 4 + b]) << (b * 8);
+                }
+                if (Crc32::compute(frame, length - 4, Crc32::ForVersion(header.protocolVersion)) != received) {
+                    ++badCrc;
+                }
+
+                uint64_t timestamp = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+                writer.write(timestamp, frame, length);
+                ++frames;
+                bytes += length;
+                offset += length;
+                if (maxCount != 0 && frames >= maxCount) {
+                    break;
+                }
+            }
+            std::memmove(buffer.data(), buffer.data() + offset, used - offset);
+            used -= offset;
+            if (maxCount != 0 && frames >= maxCount) {
+                break;
+            }
+        }
+        writer.flush();
+
+        double seconds = started ? std::chrono::duration<double>(Clock::now() - start).count() : 0.0;
+        std::printf("captured %llu frames, %llu bytes in %.3f s (bad CRC: %llu, trailing bytes: %zu)\n",
+                    static_cast<unsigned long long>(frames), static_cast<unsigned long long>(bytes), seconds,
+                    static_cast<unsigned long long>(badCrc), used);
+        if (fd != STDIN_FILENO) {
+            ::close(fd);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "sp_capture: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,285 @@
+// CoreServer 확장성 측정 도구입니다. 샤드 수를 1 에서 N 까지 늘려 가며 루프백 TCP 로 부하를 걸고,
+// 샤드 수별 처리량과 샤드 간 연결/프레임 분포를 보고합니다. (Linux)
+//
+//   sp_corebench --max-shards 8 --connections 64 --duration 5
+//   sp_corebench --max-shards 4 --mode sink --size 1024 --cpus 0,2,4,6
+//
+// echo 모드(기본)는 연결마다 --depth 개의 요청을 한 번에 보내고 응답을 모두 받은 뒤 다음 묶음을 보냅니다.
+// 서버 핸들러는 샤드 전용 버퍼에 encodeInto 로 응답을 만들어 보냅니다. sink 모드는 서버가 받기만 합니다.
+// 클라이언트 스레드는 고정하지 않으므로, 깨끗한 측정이 필요하면 --cpus 로 샤드를 일부 코어에만 두고
+// 나머지 코어에서 클라이언트가 돌도록 하십시오.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Endpoint.hpp"
+#include "streamprotocol/CoreServer.hpp"
+#include "streamprotocol/PayloadType.hpp"
+#include "streamprotocol/StreamProtocol.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    size_t maxShards = 0;
+    size_t connections = 0;         // 0 이면 샤드 수의 4배
+    double durationSeconds = 3.0;
+    size_t size = 64;
+    size_t depth = 16;
+    bool echo = true;
+    std::vector<int> cpus;
+};
+
+struct ClientResult {
+    uint64_t frames = 0;
+    std::string failure;
+};
+
+void usage() {
+    std::cerr << "usage: sp_corebench [--max-shards N] [--connections N] [--duration SEC] [--size BYTES]\n"
+                 "                    [--depth N] [--mode echo|sink] [--cpus LIST]\n";
+}
+
+std::vector<int> parseCpus(const std::string& spec) {
+    std::vector<int> cpus;
+    size_t start = 0;
+    while (start < spec.size()) {
+        size_t comma = spec.find(',', start);
+        std::string item = spec.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        char* end = nullptr;
+        long cpu = std::strtol(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || cpu < 0) {
+            throw std::invalid_argument("invalid cpu: " + item);
+        }
+        cpus.push_back(static_cast<int>(cpu));
+        if (comma == std::string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return cpus;
+}
+
+void writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            tools::throwErrno("write");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void readAll(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t count = ::read(fd, data, size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            tools::throwErrno("read");
+        }
+        if (count == 0) {
+            throw std::runtime_error("server closed the connection");
+        }
+        data += count;
+        size -= static_cast<size_t>(count);
+    }
+}
+
+/// 연결 하나에 depth 개의 프레임을 묶어 보내고, echo 모드면 같은 바이트 수만큼 응답을 받습니다.
+void runClient(uint16_t port, const Config& config, const std::vector<uint8_t>& batch, Clock::time_point stopAt,
+               ClientResult& result) {
+    tools::Endpoint endpoint = tools::parseEndpoint("tcp:127.0.0.1:" + std::to_string(port));
+    int fd = tools::connectTo(endpoint);
+    std::vector<uint8_t> replies(batch.size());
+    try {
+        while (Clock::now() < stopAt) {
+            writeAll(fd, batch.data(), batch.size());
+            if (config.echo) {
+                readAll(fd, replies.data(), replies.size());
+            }
+            result.frames += config.depth;
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+CoreServer::HandlerFactory makeHandlers(bool echo) {
+    return [echo](CoreServer::Shard&) {
+        // 응답 버퍼는 샤드마다 하나씩 두고, 첫 응답 때 샤드 스레드에서 키웁니다. (first-touch)
+        auto scratch = std::make_shared<std::vector<uint8_t>>();
+        CoreServer::Handlers handlers;
+        handlers.onFrame = [echo, scratch](CoreServer::Shard& shard, int connection, const ParsedPacketView& frame) {
+            if (!echo) {
+                return;
+            }
+            size_t needed = frame.PayloadSize() + StreamProtocol::FRAME_OVERHEAD;
+            if (scratch->size() < needed) {
+                scratch->resize(needed);
+            }
+            size_t size = shard.Protocol().encodeInto(frame.Payload(), frame.PayloadSize(), scratch->data(),
+                                                      scratch->size(), frame.PayloadType(), frame.FragmentFlag(),
+                                                      frame.UserField());
+            if (!shard.send(connection, scratch->data(), size)) {
+                shard.close(connection);
+            }
+        };
+        return handlers;
+    };
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--max-shards" && hasValue) {
+            config.maxShards = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--connections" && hasValue) {
+            config.connections = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--duration" && hasValue) {
+            config.durationSeconds = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--size" && hasValue) {
+            config.size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--depth" && hasValue) {
+            config.depth = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode != "echo" && mode != "sink") {
+                usage();
+                return 2;
+            }
+            config.echo = mode == "echo";
+        } else if (arg == "--cpus" && hasValue) {
+            try {
+                config.cpus = parseCpus(argv[++i]);
+            } catch (const std::exception&) {
+                usage();
+                return 2;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (config.maxShards == 0) {
+        config.maxShards = config.cpus.empty() ? std::max(1u, std::thread::hardware_concurrency()) : config.cpus.size();
+    }
+    if (config.durationSeconds <= 0.0 || config.size == 0 || config.depth == 0) {
+        usage();
+        return 2;
+    }
+
+    try {
+        StreamProtocol protocol;
+        std::vector<uint8_t> payload(config.size);
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<uint8_t>(i * 31u + 7u);
+        }
+        std::vector<uint8_t> frame = protocol.toBytes(payload.data(), payload.size(), PayloadType::BINARY);
+        std::vector<uint8_t> batch;
+        batch.reserve(frame.size() * config.depth);
+        for (size_t i = 0; i < config.depth; ++i) {
+            batch.insert(batch.end(), frame.begin(), frame.end());
+        }
+
+        // 1, 2, 4, ... 와 마지막으로 maxShards
+        std::vector<size_t> steps;
+        for (size_t shards = 1; shards < config.maxShards; shards *= 2) {
+            steps.push_back(shards);
+        }
+        steps.push_back(config.maxShards);
+
+        std::printf("%s mode, %zu-byte payload, depth %zu, %.1f s per step\n", config.echo ? "echo" : "sink",
+                    config.size, config.depth, config.durationSeconds);
+        std::printf("%6s %6s %12s %9s %8s %16s %18s\n", "shards", "conns", "frames/s", "MB/s", "speedup",
+                    "conns/shard", "frames/shard (M)");
+
+        double baseline = 0.0;
+        for (size_t shards : steps) {
+            CoreServer::Options options;
+            options.host = "127.0.0.1";
+            options.shards = shards;
+            options.cpus = config.cpus;
+            CoreServer server(protocol, makeHandlers(config.echo), options);
+            server.start();
+
+            size_t connections = config.connections != 0 ? config.connections : shards * 4;
+            std::vector<ClientResult> results(connections);
+            std::vector<std::thread> clients;
+            Clock::time_point start = Clock::now();
+            Clock::time_point stopAt = start + std::chrono::duration_cast<Clock::duration>(
+                                                   std::chrono::duration<double>(config.durationSeconds));
+            for (size_t c = 0; c < connections; ++c) {
+                clients.emplace_back([&, c]() {
+                    try {
+                        runClient(server.Port(), config, batch, stopAt, results[c]);
+                    } catch (const std::exception& e) {
+                        results[c].failure = e.what();
+                    }
+                });
+            }
+            for (std::thread& client : clients) {
+                client.join();
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            server.stop();
+
+            uint64_t frames = 0;
+            for (const ClientResult& result : results) {
+                if (!result.failure.empty()) {
+                    std::cerr << "sp_corebench: client failed: " << result.failure << "\n";
+                }
+                frames += result.frames;
+            }
+            uint64_t minAccepted = UINT64_MAX, maxAccepted = 0, minFrames = UINT64_MAX, maxFrames = 0;
+            for (size_t i = 0; i < server.Shards(); ++i) {
+                CoreServer::ShardStats stats = server.Stats(i);
+                minAccepted = std::min(minAccepted, stats.accepted);
+                maxAccepted = std::max(maxAccepted, stats.accepted);
+                minFrames = std::min(minFrames, stats.frames);
+                maxFrames = std::max(maxFrames, stats.frames);
+            }
+
+            double rate = frames / seconds;
+            if (baseline == 0.0) {
+                baseline = rate;
+            }
+            char balance[32];
+            char frameBalance[32];
+            std::snprintf(balance, sizeof(balance), "%llu-%llu", static_cast<unsigned long long>(minAccepted),
+                          static_cast<unsigned long long>(maxAccepted));
+            std::snprintf(frameBalance, sizeof(frameBalance), "%.2f-%.2f", minFrames / 1e6, maxFrames / 1e6);
+            std::printf("%6zu %6zu %12.0f %9.1f %7.2fx %16s %18s\n", shards, connections, rate,
+                        rate * frame.size() / 1e6, baseline > 0.0 ? rate / baseline : 0.0, balance, frameBalance);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "sp_corebench: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
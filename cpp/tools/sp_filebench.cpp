@@ -0,0 +1,309 @@
+// FileFrameSender 측정/검증 도구입니다. 파일을 프레임 단위로 나눠 소켓으로 보내고, 수신 측에서 CRC 를 검증하고
+// 페이로드를 파일 내용과 바이트 단위로 비교한 뒤, 전송 경로별 처리량을 보고합니다. (Linux)
+//
+//   sp_filebench --size 268435456 --frame-size 1048576
+//   sp_filebench --file /var/data/blob --transport tcp --mode sendfile --iterations 5
+//
+// 경로(--mode): sendfile(커널 안 전송) 와 copy(pread/write 대체 경로). 기본은 둘 다.
+// 전송(--transport): socketpair(Unix 소켓 쌍) 와 tcp(루프백). 기본은 둘 다.
+// --file 이 없으면 --size 바이트의 난수 임시 파일을 만들어 씁니다. 첫 측정 전에 파일을 한 번 읽어 페이지 캐시에 올립니다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Endpoint.hpp"
+#include "streamprotocol/FileFrame.hpp"
+#include "streamprotocol/PayloadType.hpp"
+#include "streamprotocol/StreamProtocol.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    std::string file;
+    uint64_t size = 64u * 1024u * 1024u;
+    uint64_t frameSize = 1024u * 1024u;
+    unsigned iterations = 3;
+    bool sendfileMode = true;
+    bool copyMode = true;
+    bool socketpairTransport = true;
+    bool tcpTransport = true;
+};
+
+struct ReceiveResult {
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    std::string failure;
+};
+
+void usage() {
+    std::cerr << "usage: sp_filebench [--file PATH | --size BYTES] [--frame-size BYTES] [--iterations N]\n"
+                 "                    [--mode sendfile|copy|both] [--transport socketpair|tcp|both]\n";
+}
+
+void readAll(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t count = ::read(fd, data, size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            tools::throwErrno("read");
+        }
+        if (count == 0) {
+            throw std::runtime_error("sender closed the connection early");
+        }
+        data += count;
+        size -= static_cast<size_t>(count);
+    }
+}
+
+/// --size 바이트의 난수 임시 파일을 만듭니다. 이름은 바로 지우고 fd 만 씁니다.
+int createTempFile(uint64_t size) {
+    char path[] = "/tmp/sp_filebench.XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0) {
+        tools::throwErrno("mkstemp");
+    }
+    ::unlink(path);
+    std::mt19937_64 rng(0x5EED);
+    std::vector<uint64_t> block(128u * 1024u);
+    uint64_t written = 0;
+    while (written < size) {
+        for (uint64_t& word : block) {
+            word = rng();
+        }
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(size - written, block.size() * sizeof(uint64_t)));
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(block.data());
+        size_t done = 0;
+        while (done < chunk) {
+            ssize_t n = ::write(fd, data + done, chunk - done);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                int saved = errno;
+                ::close(fd);
+                errno = saved;
+                tools::throwErrno("write temp file");
+            }
+            done += static_cast<size_t>(n);
+        }
+        written += chunk;
+    }
+    return fd;
+}
+
+/// 연결된 소켓 쌍을 만듭니다. [0] 은 송신, [1] 은 수신 쪽입니다.
+void connectPair(bool tcp, int fds[2]) {
+    if (!tcp) {
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+            tools::throwErrno("socketpair");
+        }
+        return;
+    }
+    tools::Endpoint endpoint = tools::parseEndpoint("tcp:127.0.0.1:0");
+    int listener = tools::listenOn(endpoint, 1);
+    try {
+        tools::Endpoint target = endpoint;
+        target.port = tools::boundPort(listener);
+        fds[0] = tools::connectTo(target);
+        fds[1] = tools::acceptFrom(listener, endpoint);
+    } catch (...) {
+        ::close(listener);
+        throw;
+    }
+    ::close(listener);
+}
+
+/// 프레임을 하나씩 받아 CRC 를 검증하고(parsePacketView) 페이로드를 파일 내용과 비교합니다.
+void receiveFrames(int fd, const StreamProtocol& protocol, const uint8_t* expected, const Config& config,
+                   uint64_t fileSize, ReceiveResult& result) {
+    try {
+        std::vector<uint8_t> frame(static_cast<size_t>(std::min(config.frameSize, fileSize)) +
+                                   StreamProtocol::FRAME_OVERHEAD);
+        for (unsigned iteration = 0; iteration < config.iterations; ++iteration) {
+            for (uint64_t offset = 0; offset < fileSize; offset += config.frameSize) {
+                readAll(fd, frame.data(), StreamProtocol::HEADER_SIZE);
+                size_t length = static_cast<size_t>(protocol.decodeHeader(frame.data()).packetLength);
+                if (length > frame.size()) {
+                    throw std::runtime_error("frame larger than --frame-size: " + std::to_string(length));
+                }
+                readAll(fd, frame.data() + StreamProtocol::HEADER_SIZE, length - StreamProtocol::HEADER_SIZE);
+                ParsedPacketView view = protocol.parsePacketView(frame.data(), length);
+
+                uint64_t want = std::min(config.frameSize, fileSize - offset);
+                if (view.PayloadSize() != want) {
+                    throw std::runtime_error("payload size " + std::to_string(view.PayloadSize()) + " at offset " +
+                                             std::to_string(offset) + ", expected " + std::to_string(want));
+                }
+                if (want != 0 && std::memcmp(view.Payload(), expected + offset, static_cast<size_t>(want)) != 0) {
+                    throw std::runtime_error("payload differs from the file at offset " + std::to_string(offset));
+                }
+                ++result.frames;
+                result.bytes += want;
+            }
+        }
+    } catch (const std::exception& e) {
+        result.failure = e.what();
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--file" && hasValue) {
+            config.file = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            config.size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--frame-size" && hasValue) {
+            config.frameSize = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--iterations" && hasValue) {
+            config.iterations = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--mode" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode != "sendfile" && mode != "copy" && mode != "both") {
+                usage();
+                return 2;
+            }
+            config.sendfileMode = mode != "copy";
+            config.copyMode = mode != "sendfile";
+        } else if (arg == "--transport" && hasValue) {
+            std::string transport = argv[++i];
+            if (transport != "socketpair" && transport != "tcp" && transport != "both") {
+                usage();
+                return 2;
+            }
+            config.socketpairTransport = transport != "tcp";
+            config.tcpTransport = transport != "socketpair";
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (config.frameSize == 0 || config.frameSize > StreamProtocol::MAX_PAYLOAD_LENGTH || config.iterations == 0 ||
+        (config.file.empty() && config.size == 0)) {
+        usage();
+        return 2;
+    }
+
+    int fileFd = -1;
+    void* mapping = MAP_FAILED;
+    uint64_t fileSize = 0;
+    int status = 0;
+    try {
+        if (config.file.empty()) {
+            fileFd = createTempFile(config.size);
+        } else {
+            fileFd = ::open(config.file.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fileFd < 0) {
+                tools::throwErrno("open " + config.file);
+            }
+        }
+        struct stat st;
+        if (::fstat(fileFd, &st) != 0) {
+            tools::throwErrno("fstat");
+        }
+        fileSize = static_cast<uint64_t>(st.st_size);
+        if (fileSize == 0) {
+            throw std::runtime_error("file is empty");
+        }
+        // 수신 측 비교용 원본입니다. 한 번 훑어 페이지 캐시에 올려 첫 측정이 디스크 읽기에 묶이지 않게 합니다.
+        mapping = ::mmap(nullptr, static_cast<size_t>(fileSize), PROT_READ, MAP_SHARED, fileFd, 0);
+        if (mapping == MAP_FAILED) {
+            tools::throwErrno("mmap");
+        }
+        const uint8_t* expected = static_cast<const uint8_t*>(mapping);
+        volatile uint8_t sink = 0;
+        for (uint64_t offset = 0; offset < fileSize; offset += 4096) {
+            sink = sink ^ expected[offset];
+        }
+
+        StreamProtocol protocol;
+        uint64_t frameCount = (fileSize + config.frameSize - 1) / config.frameSize;
+        std::printf("%llu-byte file, %llu-byte frames (%llu per pass), %u pass(es)\n",
+                    static_cast<unsigned long long>(fileSize), static_cast<unsigned long long>(config.frameSize),
+                    static_cast<unsigned long long>(frameCount), config.iterations);
+        std::printf("%-10s %-8s %10s %10s %9s\n", "transport", "mode", "MB/s", "frames", "verified");
+
+        for (bool tcp : { false, true }) {
+            if ((tcp && !config.tcpTransport) || (!tcp && !config.socketpairTransport)) {
+                continue;
+            }
+            for (bool useSendfile : { true, false }) {
+                if ((useSendfile && !config.sendfileMode) || (!useSendfile && !config.copyMode)) {
+                    continue;
+                }
+                FileFrameSender sender(protocol, FileFrameSender::DEFAULT_MAP_WINDOW, useSendfile);
+                int fds[2];
+                connectPair(tcp, fds);
+
+                ReceiveResult received;
+                Clock::time_point start = Clock::now();
+                std::thread receiver(receiveFrames, fds[1], std::cref(protocol), expected, std::cref(config),
+                                     fileSize, std::ref(received));
+                std::string sendFailure;
+                try {
+                    for (unsigned iteration = 0; iteration < config.iterations; ++iteration) {
+                        for (uint64_t offset = 0; offset < fileSize; offset += config.frameSize) {
+                            sender.send(fds[0], fileFd, offset, std::min(config.frameSize, fileSize - offset),
+                                        PayloadType::BINARY);
+                        }
+                    }
+                } catch (const std::exception& e) {
+                    sendFailure = e.what();
+                    ::shutdown(fds[0], SHUT_RDWR);      // 수신 스레드가 read() 에서 빠져나오도록 합니다.
+                }
+                receiver.join();
+                double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                ::close(fds[0]);
+                ::close(fds[1]);
+
+                const char* transportName = tcp ? "tcp" : "socketpair";
+                const char* modeName = useSendfile ? "sendfile" : "copy";
+                if (!sendFailure.empty() || !received.failure.empty()) {
+                    std::printf("%-10s %-8s %10s %10llu %9s\n", transportName, modeName, "-",
+                                static_cast<unsigned long long>(received.frames), "FAILED");
+                    std::cerr << "sp_filebench: " << transportName << "/" << modeName << ": "
+                              << (sendFailure.empty() ? received.failure : sendFailure) << "\n";
+                    status = 1;
+                    continue;
+                }
+                std::printf("%-10s %-8s %10.1f %10llu %9s\n", transportName, modeName, received.bytes / seconds / 1e6,
+                            static_cast<unsigned long long>(received.frames), "yes");
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "sp_filebench: " << e.what() << "\n";
+        status = 1;
+    }
+    if (mapping != MAP_FAILED) {
+        ::munmap(mapping, static_cast<size_t>(fileSize));
+    }
+    if (fileFd >= 0) {
+        ::close(fileFd);
+    }
+    return status;
+}
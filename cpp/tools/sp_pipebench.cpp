@@ -0,0 +1,167 @@
+// ReceivePipeline 확장성 측정 도구입니다. 워커 수를 1 에서 N 까지 늘려 가며 같은 프레임 묶음을 제출하고,
+// 워커 수별 처리량(frames/s, MB/s), 1워커 대비 배율, 훔쳐 온 작업 비율을 보고합니다.
+//
+//   sp_pipebench --max-workers 8 --frames 500000 --size 1024
+//   sp_pipebench --max-workers 4 --submitters 2 --streams 64 --version 2 --by-user
+//
+// 제출 스레드는 I/O 스레드처럼 미리 인코딩해 둔 프레임을 새 버퍼로 복사해 submit() 합니다.
+// 워커가 많아 제출 쪽이 먼저 포화되면 --submitters 를 늘리십시오. (스트림은 제출 스레드별로 나뉩니다)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "streamprotocol/PayloadType.hpp"
+#include "streamprotocol/ReceivePipeline.hpp"
+#include "streamprotocol/StreamProtocol.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    size_t maxWorkers = 0;
+    size_t submitters = 1;
+    size_t streams = 16;
+    size_t frames = 200000;         // 단계마다 제출하는 프레임 수
+    size_t size = 1024;
+    size_t maxInFlight = 4096;
+    uint8_t version = StreamProtocol::DEFAULT_PROTOCOL_VERSION;
+    bool byUserField = false;
+};
+
+void usage() {
+    std::cerr << "usage: sp_pipebench [--max-workers N] [--submitters N] [--streams N] [--frames N] [--size BYTES]\n"
+                 "                    [--max-in-flight N] [--version 1|2] [--by-user]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--max-workers" && hasValue) {
+            config.maxWorkers = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--submitters" && hasValue) {
+            config.submitters = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--streams" && hasValue) {
+            config.streams = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--frames" && hasValue) {
+            config.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--size" && hasValue) {
+            config.size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--max-in-flight" && hasValue) {
+            config.maxInFlight = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--version" && hasValue) {
+            config.version = static_cast<uint8_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--by-user") {
+            config.byUserField = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (config.maxWorkers == 0) {
+        config.maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (config.submitters == 0 || config.streams < config.submitters || config.frames == 0 || config.maxInFlight == 0 ||
+        config.version > 0x0F) {
+        usage();
+        return 2;
+    }
+
+    try {
+        StreamProtocol protocol;
+        protocol.SetProtocolVersion(config.version);
+        std::vector<uint8_t> payload(config.size);
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<uint8_t>(i * 31u + 7u);
+        }
+        // userField 를 돌려 가며 써서 --by-user 일 때 순서 단위가 나뉘도록 합니다.
+        std::vector<std::vector<uint8_t>> templates;
+        for (uint16_t user = 0; user < 8; ++user) {
+            templates.push_back(protocol.toBytes(payload.data(), payload.size(), PayloadType::BINARY,
+                                                 StreamProtocol::UNFRAGED, user));
+        }
+        size_t frameSize = templates[0].size();
+
+        // 1, 2, 4, ... 와 마지막으로 maxWorkers
+        std::vector<size_t> steps;
+        for (size_t workers = 1; workers < config.maxWorkers; workers *= 2) {
+            steps.push_back(workers);
+        }
+        steps.push_back(config.maxWorkers);
+
+        std::printf("%zu-byte frames, %zu frames per step, %zu submitter(s), %zu stream(s), CRC v%u%s\n", frameSize,
+                    config.frames, config.submitters, config.streams, static_cast<unsigned>(config.version),
+                    config.byUserField ? ", ordered by userField" : "");
+        std::printf("%7s %12s %9s %8s %8s\n", "workers", "frames/s", "MB/s", "speedup", "stolen");
+
+        double baseline = 0.0;
+        for (size_t workers : steps) {
+            std::atomic<uint64_t> delivered{ 0 };
+            std::atomic<uint64_t> failed{ 0 };
+            ReceivePipeline::Options options;
+            options.workers = workers;
+            options.maxInFlight = config.maxInFlight;
+            options.orderByUserField = config.byUserField;
+            ReceivePipeline pipeline(
+                protocol,
+                [&](uint64_t, const ParsedPacketView&, std::vector<uint8_t>&&) {
+                    delivered.fetch_add(1, std::memory_order_relaxed);
+                },
+                [&](uint64_t, std::exception_ptr) { failed.fetch_add(1, std::memory_order_relaxed); }, options);
+
+            Clock::time_point start = Clock::now();
+            std::vector<std::thread> threads;
+            for (size_t s = 0; s < config.submitters; ++s) {
+                threads.emplace_back([&, s] {
+                    size_t count = config.frames / config.submitters + (s < config.frames % config.submitters ? 1 : 0);
+                    for (size_t i = 0; i < count; ++i) {
+                        // 같은 스트림은 한 제출 스레드만 씁니다: 스트림 = s + k * submitters
+                        uint64_t stream = s + (i % (config.streams / config.submitters)) * config.submitters;
+                        const std::vector<uint8_t>& frame = templates[i % templates.size()];
+                        pipeline.submit(stream, std::vector<uint8_t>(frame.begin(), frame.end()));
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            pipeline.drain();
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (failed.load() != 0 || delivered.load() != config.frames) {
+                std::cerr << "sp_pipebench: delivered " << delivered.load() << " of " << config.frames << ", "
+                          << failed.load() << " failed\n";
+                return 1;
+            }
+            uint64_t stolen = 0;
+            for (size_t i = 0; i < pipeline.Workers(); ++i) {
+                stolen += pipeline.Stats(i).stolen;
+            }
+
+            double rate = config.frames / seconds;
+            if (baseline == 0.0) {
+                baseline = rate;
+            }
+            std::printf("%7zu %12.0f %9.1f %7.2fx %7.1f%%\n", workers, rate, rate * frameSize / 1e6, rate / baseline,
+                        100.0 * stolen / config.frames);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "sp_pipebench: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
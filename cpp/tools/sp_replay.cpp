@@ -0,0 +1,158 @@
+// sp_capture 로 기록한 트래픽을 TCP / Unix 소켓으로 재생합니다.
+//
+//   sp_replay -i traffic.spcap --connect tcp:127.0.0.1:9000                 # 원래 속도
+//   sp_replay -i traffic.spcap --connect unix:/tmp/svc.sock --rate 4        # 4배속
+//   sp_replay -i traffic.spcap --connect tcp:9000 --rate max --loop 10      # 최대 속도, 10회 반복
+//
+// 마감 시각이 된 프레임들을 모아 writev 한 번으로 보내고, 프레임별 송신 지연
+// (보낼 시각 또는 대기열에 들어간 시각 중 늦은 쪽 -> writev 완료)의 백분위를 보고합니다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Endpoint.hpp"
+#include "streamprotocol/Capture.hpp"
+#include "streamprotocol/SendCoalescer.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void usage() {
+    std::cerr << "usage: sp_replay -i FILE --connect ENDPOINT [--rate original|max|SCALE] [--batch-bytes N] [--loop N]\n"
+                 "  ENDPOINT: tcp:[HOST:]PORT | unix:PATH\n";
+}
+
+double percentile(std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[std::min(index, sorted.size() - 1)]) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string input;
+    std::string connectSpec;
+    double scale = 1.0;     // 0 이면 최대 속도
+    size_t batchBytes = 64 * 1024;
+    unsigned loops = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-i" && hasValue) {
+            input = argv[++i];
+        } else if (arg == "--connect" && hasValue) {
+            connectSpec = argv[++i];
+        } else if (arg == "--rate" && hasValue) {
+            std::string rate = argv[++i];
+            scale = rate == "max" ? 0.0 : rate == "original" ? 1.0 : std::strtod(rate.c_str(), nullptr);
+            if (scale < 0.0) {
+                usage();
+                return 2;
+            }
+        } else if (arg == "--batch-bytes" && hasValue) {
+            batchBytes = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--loop" && hasValue) {
+            loops = static_cast<unsigned>(std::max(1ul, std::strtoul(argv[++i], nullptr, 10)));
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (input.empty() || connectSpec.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        int fd = tools::connectTo(tools::parseEndpoint(connectSpec));
+        SendCoalescer::Sink sink = SendCoalescer::FdSink(fd);
+
+        SendCoalescer::Batch batch;
+        std::vector<Clock::time_point> readyAt;
+        size_t pendingBytes = 0;
+        std::vector<uint64_t> latencies;
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t batches = 0;
+
+        auto flush = [&]() {
+            if (batch.empty()) {
+                return;
+            }
+            sink(batch);
+            Clock::time_point done = Clock::now();
+            for (const Clock::time_point& ready : readyAt) {
+                latencies.push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(done - ready).count()));
+            }
+            batch.clear();
+            readyAt.clear();
+            pendingBytes = 0;
+            ++batches;
+        };
+
+        Clock::time_point start = Clock::now();
+        for (unsigned loop = 0; loop < loops; ++loop) {
+            std::ifstream file(input, std::ios::binary);
+            if (!file) {
+                std::cerr << "cannot open " << input << "\n";
+                return 1;
+            }
+            CaptureReader reader(file);
+            Clock::time_point loopStart = Clock::now();
+            CaptureRecord record;
+            while (reader.next(record)) {
+                Clock::time_point due = loopStart;
+                if (scale > 0.0) {
+                    due += std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(record.timestampNs) / scale));
+                    if (due > Clock::now()) {
+                        // 아직 보낼 시각이 아니면 모아 둔 배치를 먼저 보내고 기다립니다.
+                        flush();
+                        std::this_thread::sleep_until(due);
+                    }
+                }
+                Clock::time_point now = Clock::now();
+                readyAt.push_back(std::max(due, now));
+                pendingBytes += record.frame.size();
+                bytes += record.frame.size();
+                ++frames;
+                batch.push_back(std::move(record.frame));
+                record.frame = std::vector<uint8_t>();
+                if (pendingBytes >= batchBytes) {
+                    flush();
+                }
+            }
+        }
+        flush();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        ::close(fd);
+
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("replayed %llu frames, %llu bytes in %.3f s (%llu writev batches)\n",
+                    static_cast<unsigned long long>(frames), static_cast<unsigned long long>(bytes), seconds,
+                    static_cast<unsigned long long>(batches));
+        std::printf("throughput: %.0f frames/s, %.2f MB/s\n",
+                    seconds > 0 ? frames / seconds : 0.0, seconds > 0 ? bytes / seconds / 1e6 : 0.0);
+        std::printf("send latency (us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+                    percentile(latencies, 50), percentile(latencies, 90), percentile(latencies, 99),
+                    percentile(latencies, 99.9), percentile(latencies, 100));
+    } catch (const std::exception& e) {
+        std::cerr << "sp_replay: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
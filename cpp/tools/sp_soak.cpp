@@ -0,0 +1,410 @@
+// 루프백 소크/지연 측정 도구입니다. 한 프로세스 안에서 N 개의 송신/수신 쌍을 TCP 또는 Unix 소켓으로
+// 연결하고, 라이브러리의 인코딩(toBytes)과 파싱(decodeHeader + parsePacketView) 경로로 메시지를 흘립니다.
+//
+//   sp_soak --pairs 4 --transport tcp --duration 30
+//   sp_soak --transport unix --sizes 64:60,4096:30,1048576:10 --frag-size 65536 --rate 20000
+//
+// 메시지마다 첫 페이로드 8바이트에 송신 시각(steady_clock, ns)을 넣고, 수신 측이 마지막 조각까지
+// 받은 시각과의 차이를 단방향 지연으로 기록합니다. 크기별로 처리량과 p50/p99/p99.9 를 보고합니다.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Endpoint.hpp"
+#include "streamprotocol/LatencyHistogram.hpp"
+#include "streamprotocol/PayloadType.hpp"
+#include "streamprotocol/StreamProtocol.hpp"
+
+using namespace streamprotocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t MESSAGE_PREFIX = 8 + 4;    // 송신 시각(u64) + 메시지 전체 크기(u32)
+
+struct SizeClass {
+    size_t size = 0;
+    unsigned weight = 1;
+};
+
+struct Config {
+    unsigned pairs = 1;
+    bool unixSocket = false;
+    double durationSeconds = 10.0;
+    double ratePerPair = 0.0;       // 쌍당 초당 메시지 수, 0 이면 최대 속도
+    size_t fragSize = 0;            // 0 이면 조각내지 않음
+    std::vector<SizeClass> sizes;
+};
+
+struct ClassResult {
+    LatencyHistogram latency;
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+};
+
+struct PairResult {
+    std::vector<ClassResult> classes;
+    uint64_t frames = 0;
+    uint64_t errors = 0;
+    std::string receiverFailure;    // 수신 스레드만 씁니다
+    std::string senderFailure;      // 송신 스레드만 씁니다
+};
+
+void usage() {
+    std::cerr << "usage: sp_soak [--pairs N] [--transport tcp|unix] [--duration SEC] [--rate MSG_PER_SEC]\n"
+                 "               [--sizes SIZE:WEIGHT,...] [--frag-size BYTES]\n";
+}
+
+std::vector<SizeClass> parseSizes(const std::string& spec) {
+    std::vector<SizeClass> sizes;
+    size_t start = 0;
+    while (start < spec.size()) {
+        size_t comma = spec.find(',', start);
+        std::string item = spec.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        size_t colon = item.find(':');
+        SizeClass sizeClass;
+        sizeClass.size = std::strtoull(item.c_str(), nullptr, 10);
+        if (colon != std::string::npos) {
+            sizeClass.weight = static_cast<unsigned>(std::strtoul(item.c_str() + colon + 1, nullptr, 10));
+        }
+        if (sizeClass.size < MESSAGE_PREFIX || sizeClass.size > UINT32_MAX || sizeClass.weight == 0) {
+            throw std::invalid_argument("invalid size class: " + item);
+        }
+        sizes.push_back(sizeClass);
+        if (comma == std::string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    if (sizes.empty() || sizes.size() > 1024) {
+        throw std::invalid_argument("--sizes needs 1-1024 classes");
+    }
+    return sizes;
+}
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+void writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            tools::throwErrno("write");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void putLE(uint8_t* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+uint64_t getLE(const uint8_t* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (i * 8);
+    }
+    return value;
+}
+
+/// 크기 분포에 따라 메시지를 만들어 보냅니다. 큰 메시지는 fragSize 단위 조각(FRAGED ... UNFRAGED)으로 나눕니다.
+void runSender(int fd, const Config& config, Clock::time_point stopAt, unsigned seed) {
+    StreamProtocol protocol;
+    std::mt19937 random(seed);
+    std::vector<unsigned> weights;
+    for (const SizeClass& sizeClass : config.sizes) {
+        weights.push_back(sizeClass.weight);
+    }
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+
+    size_t largest = 0;
+    for (const SizeClass& sizeClass : config.sizes) {
+        largest = std::max(largest, sizeClass.size);
+    }
+    std::vector<uint8_t> message(largest);
+    for (size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<uint8_t>(random());
+    }
+
+    Clock::time_point next = Clock::now();
+    std::chrono::nanoseconds interval(config.ratePerPair > 0.0
+                                          ? static_cast<int64_t>(1e9 / config.ratePerPair)
+                                          : 0);
+    while (Clock::now() < stopAt) {
+        if (interval.count() > 0) {
+            // 개방 루프: 예정 시각을 송신 시각으로 삼아, 밀린 만큼도 지연에 포함되게 합니다.
+            if (next > Clock::now()) {
+                std::this_thread::sleep_until(next);
+            }
+        }
+        size_t index = pick(random);
+        size_t size = config.sizes[index].size;
+        uint64_t sentAt = interval.count() > 0
+                              ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    next.time_since_epoch()).count())
+                              : nowNs();
+        putLE(message.data(), sentAt, 8);
+        putLE(message.data() + 8, size, 4);
+
+        size_t chunk = config.fragSize == 0 ? size : config.fragSize;
+        for (size_t offset = 0; offset < size; offset += chunk) {
+            size_t length = std::min(chunk, size - offset);
+            uint8_t fragFlag = offset + length < size ? StreamProtocol::FRAGED : StreamProtocol::UNFRAGED;
+            std::vector<uint8_t> frame = protocol.toBytes(message.data() + offset, length, PayloadType::BINARY,
+                                                          fragFlag, static_cast<uint16_t>(index));
+            writeAll(fd, frame.data(), frame.size());
+        }
+        next += interval;
+    }
+}
+
+/// 프레임 경계를 헤더로 찾아 parsePacketView 로 검증하고, 조각을 모아 메시지 단위로 지연을 기록합니다.
+void runReceiver(int fd, const Config& config, PairResult& result) {
+    StreamProtocol protocol;
+    result.classes.resize(config.sizes.size());
+
+    std::vector<uint8_t> buffer(1u << 20);
+    size_t begin = 0;
+    size_t end = 0;
+    bool inMessage = false;
+    uint64_t sentAt = 0;
+    uint64_t expected = 0;
+    uint64_t received = 0;
+
+    for (;;) {
+        if (begin == end) {
+            begin = end = 0;
+        }
+        if (end == buffer.size()) {
+            // 남은 바이트를 앞으로 당기고, 그래도 모자라면 프레임이 들어갈 만큼 늘립니다.
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+            if (end == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+        }
+        ssize_t count = ::read(fd, buffer.data() + end, buffer.size() - end);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            tools::throwErrno("read");
+        }
+        if (count == 0) {
+            return;
+        }
+        end += static_cast<size_t>(count);
+
+        while (end - begin >= StreamProtocol::HEADER_SIZE) {
+            FrameHeader header = protocol.decodeHeader(buffer.data() + begin);
+            size_t length = static_cast<size_t>(header.packetLength);
+            if (end - begin < length) {
+                if (length > buffer.size()) {
+                    buffer.resize(length);
+                }
+                break;
+            }
+            ParsedPacketView frame = protocol.parsePacketView(buffer.data() + begin, length);
+            begin += length;
+            ++result.frames;
+
+            if (!inMessage) {
+                if (frame.PayloadSize() < MESSAGE_PREFIX) {
+                    ++result.errors;
+                    continue;
+                }
+                sentAt = getLE(frame.Payload(), 8);
+                expected = getLE(frame.Payload() + 8, 4);
+                received = 0;
+                inMessage = true;
+            }
+            received += frame.PayloadSize();
+            if (frame.FragmentFlag() == StreamProtocol::FRAGED) {
+                continue;
+            }
+
+            inMessage = false;
+            uint16_t index = frame.UserField();
+            if (index >= result.classes.size() || received != expected) {
+                ++result.errors;
+                continue;
+            }
+            uint64_t now = nowNs();
+            ClassResult& sizeResult = result.classes[index];
+            sizeResult.latency.record(now > sentAt ? now - sentAt : 0);
+            ++sizeResult.messages;
+            sizeResult.bytes += received;
+        }
+    }
+}
+
+std::string formatSize(size_t size) {
+    char text[32];
+    if (size >= (1u << 20) && size % (1u << 20) == 0) {
+        std::snprintf(text, sizeof(text), "%zuMiB", size >> 20);
+    } else if (size >= 1024 && size % 1024 == 0) {
+        std::snprintf(text, sizeof(text), "%zuKiB", size >> 10);
+    } else {
+        std::snprintf(text, sizeof(text), "%zuB", size);
+    }
+    return text;
+}
+
+void printRow(const std::string& label, const ClassResult& result, double seconds) {
+    auto us = [&](double p) { return static_cast<double>(result.latency.ValueAtPercentile(p)) / 1000.0; };
+    std::printf("%-8s %10llu %10.0f %9.2f %9.1f %9.1f %9.1f %9.1f %10.1f\n", label.c_str(),
+                static_cast<unsigned long long>(result.messages), result.messages / seconds,
+                result.bytes / seconds / 1e6, result.latency.Mean() / 1000.0, us(50), us(99), us(99.9),
+                static_cast<double>(result.latency.Max()) / 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+    std::string sizeSpec = "64:50,1024:30,16384:15,262144:5";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--pairs" && hasValue) {
+            config.pairs = static_cast<unsigned>(std::max(1ul, std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--transport" && hasValue) {
+            std::string transport = argv[++i];
+            if (transport != "tcp" && transport != "unix") {
+                usage();
+                return 2;
+            }
+            config.unixSocket = transport == "unix";
+        } else if (arg == "--duration" && hasValue) {
+            config.durationSeconds = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--rate" && hasValue) {
+            config.ratePerPair = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--sizes" && hasValue) {
+            sizeSpec = argv[++i];
+        } else if (arg == "--frag-size" && hasValue) {
+            config.fragSize = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (config.durationSeconds <= 0.0 || config.ratePerPair < 0.0 ||
+        (config.fragSize != 0 && config.fragSize < MESSAGE_PREFIX)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        config.sizes = parseSizes(sizeSpec);
+
+        std::vector<int> senders;
+        std::vector<int> receivers;
+        for (unsigned pair = 0; pair < config.pairs; ++pair) {
+            tools::Endpoint endpoint = tools::parseEndpoint(
+                config.unixSocket ? "unix:/tmp/sp_soak." + std::to_string(::getpid()) + "." + std::to_string(pair)
+                                  : std::string("tcp:127.0.0.1:0"));
+            int listener = tools::listenOn(endpoint, 1);
+            tools::Endpoint target = endpoint;
+            if (!config.unixSocket) {
+                target.port = tools::boundPort(listener);
+            }
+            senders.push_back(tools::connectTo(target));
+            receivers.push_back(tools::acceptFrom(listener, endpoint));
+            ::close(listener);
+            if (config.unixSocket) {
+                ::unlink(endpoint.path.c_str());
+            }
+        }
+
+        std::vector<PairResult> results(config.pairs);
+        std::vector<std::thread> threads;
+        Clock::time_point start = Clock::now();
+        Clock::time_point stopAt = start + std::chrono::duration_cast<Clock::duration>(
+                                               std::chrono::duration<double>(config.durationSeconds));
+        for (unsigned pair = 0; pair < config.pairs; ++pair) {
+            threads.emplace_back([&, pair]() {
+                try {
+                    runReceiver(receivers[pair], config, results[pair]);
+                } catch (const std::exception& e) {
+                    results[pair].receiverFailure = e.what();
+                }
+            });
+            threads.emplace_back([&, pair]() {
+                try {
+                    runSender(senders[pair], config, stopAt, 0x5EED0000u + pair);
+                } catch (const std::exception& e) {
+                    results[pair].senderFailure = e.what();
+                }
+                ::shutdown(senders[pair], SHUT_WR);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        for (unsigned pair = 0; pair < config.pairs; ++pair) {
+            ::close(senders[pair]);
+            ::close(receivers[pair]);
+        }
+
+        std::vector<ClassResult> merged(config.sizes.size());
+        ClassResult total;
+        uint64_t frames = 0;
+        uint64_t errors = 0;
+        for (const PairResult& result : results) {
+            for (const std::string* failure : { &result.receiverFailure, &result.senderFailure }) {
+                if (!failure->empty()) {
+                    std::cerr << "sp_soak: pair failed: " << *failure << "\n";
+                    ++errors;
+                }
+            }
+            frames += result.frames;
+            errors += result.errors;
+            for (size_t i = 0; i < result.classes.size(); ++i) {
+                merged[i].latency.merge(result.classes[i].latency);
+                merged[i].messages += result.classes[i].messages;
+                merged[i].bytes += result.classes[i].bytes;
+                total.latency.merge(result.classes[i].latency);
+                total.messages += result.classes[i].messages;
+                total.bytes += result.classes[i].bytes;
+            }
+        }
+
+        std::printf("%u pair(s) over %s, %.2f s, %llu frames, %llu errors\n", config.pairs,
+                    config.unixSocket ? "unix" : "tcp", seconds, static_cast<unsigned long long>(frames),
+                    static_cast<unsigned long long>(errors));
+        std::printf("%-8s %10s %10s %9s %9s %9s %9s %9s %10s\n", "size", "messages", "msg/s", "MB/s",
+                    "mean(us)", "p50", "p99", "p99.9", "max");
+        for (size_t i = 0; i < config.sizes.size(); ++i) {
+            printRow(formatSize(config.sizes[i].size), merged[i], seconds);
+        }
+        printRow("all", total, seconds);
+        return errors == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "sp_soak: " << e.what() << "\n";
+        return 1;
+    }
+}